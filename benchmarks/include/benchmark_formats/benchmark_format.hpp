@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pl/helpers/types.hpp>
+
+#include "benchmark_random.hpp"
+
+#define BENCHMARK(name) (pl::bench::BenchmarkFormat *)new pl::bench::BenchmarkFormat##name()
+
+namespace pl::bench {
+
+    class BenchmarkFormat {
+    public:
+        explicit BenchmarkFormat(const std::string &name) {
+            BenchmarkFormat::s_formats.insert({ name, this });
+        }
+
+        virtual ~BenchmarkFormat() = default;
+
+        // Both the data and the source code only depend on the requested size so runs are reproducible
+        [[nodiscard]] virtual std::string getSourceCode(u64 dataSize) const = 0;
+        [[nodiscard]] virtual std::vector<u8> generateData(u64 dataSize) const = 0;
+
+        [[nodiscard]] static auto &getFormats() {
+            return BenchmarkFormat::s_formats;
+        }
+
+    private:
+        static inline std::map<std::string, BenchmarkFormat *> s_formats;
+    };
+
+}
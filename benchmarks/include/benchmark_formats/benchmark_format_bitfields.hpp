@@ -0,0 +1,37 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatBitfields : public BenchmarkFormat {
+    public:
+        BenchmarkFormatBitfields() : BenchmarkFormat("Bitfields") { }
+        ~BenchmarkFormatBitfields() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            return fmt::format(R"(
+                {}
+                bitfield Flags {{
+                    a : 3;
+                    b : 5;
+                    c : 4;
+                    d : 12;
+                    e : 8;
+                }};
+
+                Flags flags[{}] @ 0x00;
+            )", Pragmas, dataSize / sizeof(u32));
+        }
+
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random(0x42495446).fill(data.data(), data.size());
+
+            return data;
+        }
+    };
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatDynamicArrays : public BenchmarkFormat {
+    public:
+        BenchmarkFormatDynamicArrays() : BenchmarkFormat("DynamicArrays") { }
+        ~BenchmarkFormatDynamicArrays() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            return fmt::format(R"(
+                {}
+                struct Record {{
+                    u8 length;
+                    u8 payload[length];
+                }};
+
+                Record records[while($ < {})] @ 0x00;
+            )", Pragmas, dataSize);
+        }
+
+        // Length prefixed records that exactly fill the data
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random random(0x44594E41);
+            random.fill(data.data(), data.size());
+
+            u64 offset = 0;
+            while (offset < dataSize) {
+                const auto remaining = dataSize - offset;
+
+                u8 length;
+                if (remaining <= MaxRecordSize * 2)
+                    length = u8(std::min<u64>(remaining - 1, MaxPayloadSize));
+                else
+                    length = u8(random.next(0, MaxPayloadSize));
+
+                data[offset] = length;
+                offset += 1 + length;
+            }
+
+            return data;
+        }
+
+    private:
+        static constexpr u64 MaxPayloadSize = 31;
+        static constexpr u64 MaxRecordSize  = MaxPayloadSize + 1;
+    };
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatNestedStructs : public BenchmarkFormat {
+    public:
+        BenchmarkFormatNestedStructs() : BenchmarkFormat("NestedStructs") { }
+        ~BenchmarkFormatNestedStructs() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            return fmt::format(R"(
+                {}
+                struct Vector3 {{
+                    float x, y, z;
+                }};
+
+                struct Transform {{
+                    Vector3 position;
+                    Vector3 rotation;
+                    u32 flags;
+                }};
+
+                struct Object {{
+                    Transform transform;
+                    u16 id;
+                    u16 parentId;
+                }};
+
+                Object objects[{}] @ 0x00;
+            )", Pragmas, dataSize / ObjectSize);
+        }
+
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random(0x4E455354).fill(data.data(), data.size());
+
+            return data;
+        }
+
+    private:
+        static constexpr u64 ObjectSize = 32;
+    };
+
+}
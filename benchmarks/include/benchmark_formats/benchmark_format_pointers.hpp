@@ -0,0 +1,49 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatPointers : public BenchmarkFormat {
+    public:
+        BenchmarkFormatPointers() : BenchmarkFormat("Pointers") { }
+        ~BenchmarkFormatPointers() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            return fmt::format(R"(
+                {}
+                struct Entry {{
+                    u32 *value : u32;
+                }};
+
+                Entry entries[{}] @ 0x00;
+            )", Pragmas, getEntryCount(dataSize));
+        }
+
+        // The first half of the data is a table of offsets pointing somewhere into the second half
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random random(0x504F494E);
+            random.fill(data.data(), data.size());
+
+            const auto entryCount = getEntryCount(dataSize);
+            const auto tableSize  = entryCount * sizeof(u32);
+            for (u64 i = 0; i < entryCount; i++) {
+                const u32 target = u32(random.next(tableSize, dataSize - sizeof(u32)));
+                std::memcpy(&data[i * sizeof(u32)], &target, sizeof(target));
+            }
+
+            return data;
+        }
+
+    private:
+        [[nodiscard]] static u64 getEntryCount(u64 dataSize) {
+            return dataSize / 2 / sizeof(u32);
+        }
+    };
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatPrimitiveArrays : public BenchmarkFormat {
+    public:
+        BenchmarkFormatPrimitiveArrays() : BenchmarkFormat("PrimitiveArrays") { }
+        ~BenchmarkFormatPrimitiveArrays() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            const auto half = dataSize / 2;
+
+            return fmt::format(R"(
+                {}
+                u32 integers[{}] @ 0x00;
+                float floats[{}] @ {};
+            )", Pragmas, half / sizeof(u32), half / sizeof(float), half);
+        }
+
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random(0x5052494D).fill(data.data(), data.size());
+
+            return data;
+        }
+    };
+
+}
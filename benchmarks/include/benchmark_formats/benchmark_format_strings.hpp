@@ -0,0 +1,60 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatStrings : public BenchmarkFormat {
+    public:
+        BenchmarkFormatStrings() : BenchmarkFormat("Strings") { }
+        ~BenchmarkFormatStrings() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            return fmt::format(R"(
+                {}
+                struct Entry {{
+                    char name[];
+                    u32 value;
+                }};
+
+                Entry entries[while($ < {})] @ 0x00;
+            )", Pragmas, dataSize);
+        }
+
+        // Null-terminated names of random length followed by a value, exactly filling the data
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random random(0x53545249);
+
+            u64 offset = 0;
+            while (offset < dataSize) {
+                const auto remaining = dataSize - offset;
+
+                u64 length;
+                if (remaining < MinTailSize)
+                    length = remaining - 1 - sizeof(u32);
+                else
+                    length = random.next(1, MaxNameLength);
+
+                for (u64 i = 0; i < length; i++)
+                    data[offset + i] = u8(random.next('a', 'z'));
+                data[offset + length] = 0x00;
+                offset += length + 1;
+
+                random.fill(&data[offset], sizeof(u32));
+                offset += sizeof(u32);
+            }
+
+            return data;
+        }
+
+    private:
+        static constexpr u64 MaxNameLength = 23;
+
+        // Once less than this is left, a single entry takes up the rest so the last one never gets cut off
+        static constexpr u64 MinTailSize = 2 * (MaxNameLength + 1 + sizeof(u32));
+    };
+
+}
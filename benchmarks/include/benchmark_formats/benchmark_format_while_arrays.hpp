@@ -0,0 +1,56 @@
+#pragma once
+
+#include "benchmark_format.hpp"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+namespace pl::bench {
+
+    class BenchmarkFormatWhileArrays : public BenchmarkFormat {
+    public:
+        BenchmarkFormatWhileArrays() : BenchmarkFormat("WhileArrays") { }
+        ~BenchmarkFormatWhileArrays() override = default;
+
+        [[nodiscard]] std::string getSourceCode(u64 dataSize) const override {
+            return fmt::format(R"(
+                {}
+                struct Run {{
+                    u8 values[while($[$] != 0x00)];
+                    u8 terminator;
+                }};
+
+                Run runs[while($ < {})] @ 0x00;
+            )", Pragmas, dataSize);
+        }
+
+        // Many short runs of non-zero bytes that each end in a zero byte and exactly fill the data
+        [[nodiscard]] std::vector<u8> generateData(u64 dataSize) const override {
+            std::vector<u8> data(dataSize);
+            Random random(0x57484C45);
+
+            u64 offset = 0;
+            while (offset < dataSize) {
+                const auto remaining = dataSize - offset;
+
+                u64 length;
+                if (remaining <= (MaxRunLength + 1) * 2)
+                    length = std::min<u64>(remaining - 1, MaxRunLength);
+                else
+                    length = random.next(0, MaxRunLength);
+
+                for (u64 i = 0; i < length; i++)
+                    data[offset + i] = u8(random.next(1, 0xFF));
+                data[offset + length] = 0x00;
+                offset += length + 1;
+            }
+
+            return data;
+        }
+
+    private:
+        static constexpr u64 MaxRunLength = 7;
+    };
+
+}
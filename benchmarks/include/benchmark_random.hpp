@@ -0,0 +1,39 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+namespace pl::bench {
+
+    class Random {
+    public:
+        explicit Random(u64 seed) : m_state(seed) { }
+
+        // SplitMix64, produces the same sequence on every platform unlike the std distributions
+        u64 next() {
+            u64 z = (this->m_state += 0x9E3779B97F4A7C15);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            return z ^ (z >> 31);
+        }
+
+        u64 next(u64 min, u64 max) {
+            return min + this->next() % (max - min + 1);
+        }
+
+        void fill(u8 *buffer, size_t size) {
+            for (size_t i = 0; i < size; i++)
+                buffer[i] = u8(this->next());
+        }
+
+    private:
+        u64 m_state;
+    };
+
+    // Benchmarks intentionally produce more patterns than the default limits allow
+    constexpr static auto Pragmas = R"(
+        #pragma array_limit 0
+        #pragma pattern_limit 0
+        #pragma loop_limit 0
+    )";
+
+}
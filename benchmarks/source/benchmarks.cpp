@@ -0,0 +1,19 @@
+#include <array>
+
+#include "benchmark_formats/benchmark_format_primitive_arrays.hpp"
+#include "benchmark_formats/benchmark_format_nested_structs.hpp"
+#include "benchmark_formats/benchmark_format_bitfields.hpp"
+#include "benchmark_formats/benchmark_format_pointers.hpp"
+#include "benchmark_formats/benchmark_format_dynamic_arrays.hpp"
+#include "benchmark_formats/benchmark_format_strings.hpp"
+#include "benchmark_formats/benchmark_format_while_arrays.hpp"
+
+std::array Benchmarks = {
+    BENCHMARK(PrimitiveArrays),
+    BENCHMARK(NestedStructs),
+    BENCHMARK(Bitfields),
+    BENCHMARK(Pointers),
+    BENCHMARK(DynamicArrays),
+    BENCHMARK(Strings),
+    BENCHMARK(WhileArrays),
+};
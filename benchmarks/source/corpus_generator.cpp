@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <pl/helpers/types.hpp>
+#include <wolv/io/file.hpp>
+
+#include <fmt/format.h>
+
+#include "benchmark_random.hpp"
+
+using namespace pl;
+using namespace pl::bench;
+
+/*
+ * Generates paired data and pattern files of arbitrary size to measure throughput with.
+ * Output only depends on the format, its parameters, the size and the seed so corpora
+ * can be regenerated anywhere instead of being shared.
+ */
+
+namespace {
+
+    enum class Format {
+        Fixed,
+        Variable,
+        Strings
+    };
+
+    struct Options {
+        Format format = Format::Fixed;
+        u64 size = 1024 * 1024;
+        u64 seed = 0;
+        u32 fields = 4;
+        u32 maxPayload = 64;
+        std::string outputPrefix;
+    };
+
+    // Data is produced in chunks so corpora far larger than the available memory can be written
+    class ChunkedWriter {
+    public:
+        explicit ChunkedWriter(wolv::io::File &file) : m_file(file) {
+            this->m_buffer.reserve(ChunkSize);
+        }
+
+        ~ChunkedWriter() {
+            this->flush();
+        }
+
+        template<typename T>
+        void write(const T &value) {
+            const auto bytes = reinterpret_cast<const u8 *>(&value);
+            this->m_buffer.insert(this->m_buffer.end(), bytes, bytes + sizeof(T));
+
+            if (this->m_buffer.size() >= ChunkSize)
+                this->flush();
+        }
+
+        void flush() {
+            this->m_file.writeBuffer(this->m_buffer.data(), this->m_buffer.size());
+            this->m_buffer.clear();
+        }
+
+    private:
+        static constexpr size_t ChunkSize = 1024 * 1024;
+
+        wolv::io::File &m_file;
+        std::vector<u8> m_buffer;
+    };
+
+    // struct Record { u32 id; u32 type; u64 timestamp; u32 values[fields]; }
+    std::string generateFixed(const Options &options, ChunkedWriter &writer, u64 &size) {
+        const u64 recordSize = 16 + u64(options.fields) * sizeof(u32);
+        const u64 recordCount = options.size / recordSize;
+        size = recordCount * recordSize;
+
+        Random random(options.seed);
+        u64 timestamp = 1'600'000'000;
+        for (u64 i = 0; i < recordCount; i++) {
+            timestamp += random.next(0, 1000);
+
+            writer.write(u32(i));
+            writer.write(u32(random.next(0, 15)));
+            writer.write(timestamp);
+            for (u32 field = 0; field < options.fields; field++)
+                writer.write(u32(random.next()));
+        }
+
+        return fmt::format(R"({}
+struct Record {{
+    u32 id;
+    u32 type;
+    u64 timestamp;
+    u32 values[{}];
+}};
+
+Record records[{}] @ 0x00;
+)", Pragmas, options.fields, recordCount);
+    }
+
+    // struct Record { u16 type; u16 length; u8 payload[length]; } filling the data exactly
+    std::string generateVariable(const Options &options, ChunkedWriter &writer, u64 &size) {
+        constexpr u64 HeaderSize = 2 * sizeof(u16);
+        const u64 maxRecordSize = HeaderSize + options.maxPayload;
+        size = options.size;
+
+        Random random(options.seed);
+        u64 offset = 0;
+        while (offset < size) {
+            const auto remaining = size - offset;
+
+            // Split what's left over the last two records so neither of them gets cut off
+            u16 length;
+            if (remaining <= maxRecordSize)
+                length = u16(remaining - HeaderSize);
+            else if (remaining <= maxRecordSize * 2)
+                length = u16(remaining / 2 - HeaderSize);
+            else
+                length = u16(random.next(0, options.maxPayload));
+
+            writer.write(u16(random.next(0, 15)));
+            writer.write(length);
+            for (u16 i = 0; i < length; i++)
+                writer.write(u8(random.next()));
+
+            offset += HeaderSize + length;
+        }
+
+        return fmt::format(R"({}
+struct Record {{
+    u16 type;
+    u16 length;
+    u8 payload[length];
+}};
+
+Record records[while($ < {})] @ 0x00;
+)", Pragmas, size);
+    }
+
+    // struct Entry { u32 id; char name[]; } with null-terminated names, filling the data exactly
+    std::string generateStrings(const Options &options, ChunkedWriter &writer, u64 &size) {
+        constexpr u64 MaxNameLength = 23;
+        constexpr u64 MaxEntrySize = sizeof(u32) + MaxNameLength + 1;
+        size = options.size;
+
+        Random random(options.seed);
+        u64 offset = 0;
+        for (u32 id = 0; offset < size; id++) {
+            const auto remaining = size - offset;
+
+            u64 length;
+            if (remaining < MaxEntrySize * 2)
+                length = remaining - sizeof(u32) - 1;
+            else
+                length = random.next(1, MaxNameLength);
+
+            writer.write(id);
+            for (u64 i = 0; i < length; i++)
+                writer.write(char(random.next('a', 'z')));
+            writer.write(char(0x00));
+
+            offset += sizeof(u32) + length + 1;
+        }
+
+        return fmt::format(R"({}
+struct Entry {{
+    u32 id;
+    char name[];
+}};
+
+Entry entries[while($ < {})] @ 0x00;
+)", Pragmas, size);
+    }
+
+    std::optional<u64> parseSize(const std::string &value) {
+        size_t end = 0;
+        u64 size = std::stoull(value, &end, 0);
+
+        const auto suffix = value.substr(end);
+        if (suffix.empty())                     return size;
+        else if (suffix == "K" || suffix == "k") return size << 10;
+        else if (suffix == "M" || suffix == "m") return size << 20;
+        else if (suffix == "G" || suffix == "g") return size << 30;
+        else                                     return std::nullopt;
+    }
+
+    std::optional<Options> parseOptions(int argc, char **argv) {
+        Options options;
+
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            if (i + 1 >= argc)
+                return std::nullopt;
+
+            const std::string value = argv[++i];
+            try {
+                if (argument == "--format") {
+                    if (value == "fixed")           options.format = Format::Fixed;
+                    else if (value == "variable")   options.format = Format::Variable;
+                    else if (value == "strings")    options.format = Format::Strings;
+                    else                            return std::nullopt;
+                } else if (argument == "--size") {
+                    auto size = parseSize(value);
+                    if (!size.has_value())
+                        return std::nullopt;
+                    options.size = *size;
+                } else if (argument == "--seed") {
+                    options.seed = std::stoull(value, nullptr, 0);
+                } else if (argument == "--fields") {
+                    options.fields = u32(std::stoul(value));
+                } else if (argument == "--max-payload") {
+                    options.maxPayload = u32(std::clamp<u64>(std::stoul(value), 8, 0xFFFF));
+                } else if (argument == "--output") {
+                    options.outputPrefix = value;
+                } else {
+                    return std::nullopt;
+                }
+            } catch (const std::exception &) {
+                return std::nullopt;
+            }
+        }
+
+        if (options.outputPrefix.empty() || options.size < 256)
+            return std::nullopt;
+
+        return options;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    auto options = parseOptions(argc, argv);
+    if (!options.has_value()) {
+        fmt::print("Usage: {} --output <prefix> [options]\n"
+                   "  --format <fixed|variable|strings>  Record format to generate (default fixed)\n"
+                   "  --size <bytes>[K|M|G]              Size of the data file, at least 256 bytes (default 1M)\n"
+                   "  --seed <n>                         Seed of the generated values (default 0)\n"
+                   "  --fields <n>                       Value fields per fixed record (default 4)\n"
+                   "  --max-payload <n>                  Largest payload of variable records, 8 to 65535 (default 64)\n"
+                   "Writes <prefix>.bin and the matching <prefix>.pat\n",
+                   argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    wolv::io::File dataFile(options->outputPrefix + ".bin", wolv::io::File::Mode::Create);
+    wolv::io::File patternFile(options->outputPrefix + ".pat", wolv::io::File::Mode::Create);
+    if (!dataFile.isValid() || !patternFile.isValid()) {
+        fmt::print("Failed to create output files with prefix {}!\n", options->outputPrefix);
+        return EXIT_FAILURE;
+    }
+
+    std::string sourceCode;
+    u64 size = 0;
+    {
+        ChunkedWriter writer(dataFile);
+
+        switch (options->format) {
+            case Format::Fixed:
+                sourceCode = generateFixed(*options, writer, size);
+                break;
+            case Format::Variable:
+                sourceCode = generateVariable(*options, writer, size);
+                break;
+            case Format::Strings:
+                sourceCode = generateStrings(*options, writer, size);
+                break;
+        }
+    }
+
+    patternFile.writeString(sourceCode);
+
+    fmt::print("Generated {} bytes of data in {}.bin\n", size, options->outputPrefix);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wolv/io/file.hpp>
+#include <wolv/utils/guards.hpp>
+
+#include <pl/pattern_language.hpp>
+#include <pl/formatters.hpp>
+#include <pl/core/ast/ast_node_literal.hpp>
+#include <pl/core/evaluator.hpp>
+#include <pl/helpers/static_interval_index.hpp>
+#include <wolv/container/interval_tree.hpp>
+
+#include "benchmark_formats/benchmark_format.hpp"
+
+#include <fmt/format.h>
+
+#if defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+
+using namespace pl;
+using namespace pl::bench;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string filter;
+        u64 dataSize = 256 * 1024;
+        u32 iterations = 10;
+        u32 warmupIterations = 1;
+        std::string outputPath;
+        std::string baselinePath;
+        double threshold = 10.0;
+    };
+
+    struct Result {
+        std::string name;
+        u64 dataSize;
+        std::vector<double> samples;
+
+        [[nodiscard]] double getMin() const { return *std::min_element(this->samples.begin(), this->samples.end()); }
+        [[nodiscard]] double getMax() const { return *std::max_element(this->samples.begin(), this->samples.end()); }
+        [[nodiscard]] double getMean() const { return std::accumulate(this->samples.begin(), this->samples.end(), 0.0) / double(this->samples.size()); }
+
+        [[nodiscard]] double getMedian() const {
+            auto sorted = this->samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            const auto middle = sorted.size() / 2;
+            return sorted.size() % 2 == 0 ? (sorted[middle - 1] + sorted[middle]) / 2 : sorted[middle];
+        }
+    };
+
+    void printUsage(const char *executable) {
+        fmt::print("Usage: {} [options]\n"
+                   "  --filter <name>      Only run benchmarks whose name contains <name> or whose results start with it, like \"Index/window\".\n"
+                   "                       \"Index\" and \"Hooks\" select the pattern index and debugger hook benchmarks\n"
+                   "  --size <bytes>       Size of the generated data per format (default 262144)\n"
+                   "  --iterations <n>     Measured iterations per format (default 10)\n"
+                   "  --warmup <n>         Discarded iterations per format (default 1)\n"
+                   "  --output <file>      Write results as JSON to <file>\n"
+                   "  --baseline <file>    Compare against results previously written with --output\n"
+                   "  --threshold <pct>    Median slowdown in percent counted as a regression (default 10)\n",
+                   executable);
+    }
+
+    std::optional<Options> parseOptions(int argc, char **argv) {
+        Options options;
+
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            if (argument == "--help" || argument == "-h" || i + 1 >= argc)
+                return std::nullopt;
+
+            const std::string value = argv[++i];
+            try {
+                if (argument == "--filter")
+                    options.filter = value;
+                else if (argument == "--size")
+                    options.dataSize = std::stoull(value, nullptr, 0);
+                else if (argument == "--iterations")
+                    options.iterations = u32(std::stoul(value));
+                else if (argument == "--warmup")
+                    options.warmupIterations = u32(std::stoul(value));
+                else if (argument == "--output")
+                    options.outputPath = value;
+                else if (argument == "--baseline")
+                    options.baselinePath = value;
+                else if (argument == "--threshold")
+                    options.threshold = std::stod(value);
+                else
+                    return std::nullopt;
+            } catch (const std::exception &) {
+                return std::nullopt;
+            }
+        }
+
+        // The generated formats need some room for at least a couple of records
+        if (options.iterations == 0 || options.dataSize < 256)
+            return std::nullopt;
+
+        return options;
+    }
+
+    // Benchmarks are selected if the filter is part of their name or names one of their results, like "Index/window"
+    bool isSelected(const Options &options, std::string_view name) {
+        const std::string_view filter = options.filter;
+
+        return filter.empty() || name.contains(filter) || (filter.starts_with(name) && filter.substr(name.size()).starts_with('/'));
+    }
+
+    double toNanoseconds(std::chrono::duration<double> duration) {
+        return std::chrono::duration<double, std::nano>(duration).count();
+    }
+
+    bool runBenchmark(const std::string &name, const BenchmarkFormat &format, const Options &options, std::vector<Result> &results) {
+        const auto data = format.generateData(options.dataSize);
+        const auto sourceCode = format.getSourceCode(options.dataSize);
+
+        pl::PatternLanguage runtime;
+        runtime.setDataSource(0x00, data.size(), [&data](u64 offset, u8 *buffer, size_t size) {
+            if (offset >= data.size())
+                return;
+
+            std::memcpy(buffer, data.data() + offset, std::min<u64>(size, data.size() - offset));
+        });
+        runtime.setLogCallback([](auto, const std::string &) { });
+
+        auto formatters = pl::gen::fmt::createFormatters();
+        std::vector<pl::gen::fmt::Formatter *> applicableFormatters;
+
+        std::vector<Result> stageResults;
+        auto record = [&](const std::string &stage, std::chrono::duration<double> duration) {
+            auto it = std::find_if(stageResults.begin(), stageResults.end(), [&](const Result &result) { return result.name == stage; });
+            if (it == stageResults.end()) {
+                stageResults.push_back({ stage, data.size(), { } });
+                it = stageResults.end() - 1;
+            }
+
+            it->samples.push_back(toNanoseconds(duration));
+        };
+
+        for (u32 i = 0; i < options.warmupIterations + options.iterations; i++) {
+            if (!runtime.executeString(sourceCode)) {
+                fmt::print("Benchmark {} failed to execute!\n", name);
+                if (auto error = runtime.getError(); error.has_value())
+                    fmt::print("Error: {}:{} : {}\n", error->line, error->column, error->message);
+
+                return false;
+            }
+
+            // Formatters that only export some kinds of patterns are skipped for formats they have nothing to export from
+            if (i == 0) {
+                for (auto &formatter : formatters) {
+                    if (formatter->canFormat(runtime))
+                        applicableFormatters.push_back(formatter.get());
+                }
+            }
+
+            if (i < options.warmupIterations) {
+                for (auto formatter : applicableFormatters)
+                    (void)formatter->format(runtime);
+
+                continue;
+            }
+
+            const auto &timings = runtime.getStatistics().timings;
+            record("preprocess", timings.preprocess);
+            record("lex",        timings.lex);
+            record("parse",      timings.parse);
+            record("validate",   timings.validate);
+            record("evaluate",   timings.evaluate);
+            record("flatten",    timings.flatten);
+
+            for (auto formatter : applicableFormatters) {
+                const auto start = Clock::now();
+                const auto output = formatter->format(runtime);
+                const auto end = Clock::now();
+
+                if (output.empty()) {
+                    fmt::print("Formatter {} produced no output for benchmark {}!\n", formatter->getName(), name);
+                    return false;
+                }
+
+                record(fmt::format("format_{}", formatter->getName()), end - start);
+            }
+        }
+
+        for (auto &result : stageResults) {
+            result.name = fmt::format("{}/{}", name, result.name);
+            results.push_back(std::move(result));
+        }
+
+        return true;
+    }
+
+    // Bytes currently allocated on the heap, 0 if the platform doesn't report it
+    size_t getHeapUsage() {
+        #if defined(__GLIBC__)
+            const auto info = mallinfo2();
+            return info.uordblks + info.hblkhd;
+        #else
+            return 0;
+        #endif
+    }
+
+    // Compares the static index used for pattern lookups with the interval tree it replaced
+    bool runIndexBenchmark(const Options &options, std::vector<Result> &results) {
+        using Index = hlp::StaticIntervalIndex<u64>;
+        using Tree = wolv::container::IntervalTree<u64, u64, 5>;
+
+        // 4 byte values covered by 64 byte structs, similar to what flattening an array of structs produces
+        std::vector<Index::Element> elements;
+        for (u64 address = 0; address + 4 <= options.dataSize; address += 4)
+            elements.push_back({ { address, address + 3 }, address });
+        for (u64 address = 0; address + 64 <= options.dataSize; address += 64)
+            elements.push_back({ { address, address + 63 }, address });
+
+        constexpr u32 QueryCount = 10000;
+        constexpr u64 WindowSize = 4096;
+
+        std::mt19937_64 random(0x494E444558);
+        std::vector<u64> queries(QueryCount);
+        for (auto &query : queries)
+            query = random() % options.dataSize;
+
+        std::vector<Result> stageResults;
+        for (const auto &stage : { "build_tree", "build_static", "point_tree", "point_static", "window_tree", "window_static" })
+            stageResults.push_back({ fmt::format("Index/{}", stage), options.dataSize, { } });
+
+        auto measure = [](auto &&function) {
+            const auto start = Clock::now();
+            function();
+            return toNanoseconds(Clock::now() - start);
+        };
+
+        size_t treeMemory = 0, indexMemory = 0;
+        for (u32 i = 0; i < options.warmupIterations + options.iterations; i++) {
+            Tree tree;
+            std::optional<Index> index;
+
+            const auto heapBeforeTree = getHeapUsage();
+            const auto buildTree = measure([&] {
+                for (const auto &element : elements)
+                    tree.insert({ element.interval.start, element.interval.end }, element.value);
+            });
+            const auto heapBeforeIndex = getHeapUsage();
+            const auto buildIndex = measure([&] { index.emplace(elements); });
+            treeMemory = heapBeforeIndex - heapBeforeTree;
+            indexMemory = getHeapUsage() - heapBeforeIndex;
+
+            // Both need to find the same intervals, the counts also keep the queries from being optimized out
+            size_t treeFound = 0, indexFound = 0;
+            const auto pointTree   = measure([&] { for (auto address : queries) treeFound += tree.overlapping({ address, address }).size(); });
+            const auto pointIndex  = measure([&] { for (auto address : queries) indexFound += index->overlapping({ address, address }).size(); });
+            const auto windowTree  = measure([&] { for (auto address : queries) treeFound += tree.overlapping({ address, address + WindowSize - 1 }).size(); });
+            const auto windowIndex = measure([&] { for (auto address : queries) indexFound += index->overlapping({ address, address + WindowSize - 1 }).size(); });
+
+            if (treeFound != indexFound) {
+                fmt::print("Index benchmark found {} intervals in the static index but {} in the tree!\n", indexFound, treeFound);
+                return false;
+            }
+
+            if (i < options.warmupIterations)
+                continue;
+
+            for (auto [result, sample] : { std::pair{ 0, buildTree }, { 1, buildIndex }, { 2, pointTree }, { 3, pointIndex }, { 4, windowTree }, { 5, windowIndex } })
+                stageResults[result].samples.push_back(sample);
+        }
+
+        fmt::print("Index: {} intervals, {} queries per run\n", elements.size(), QueryCount);
+        if (treeMemory != 0 || indexMemory != 0)
+            fmt::print("  Memory [B/interval]        tree {:>8.1f}   static {:>8.1f}\n", double(treeMemory) / double(elements.size()), double(indexMemory) / double(elements.size()));
+        fmt::print("  Point query [ns]           tree {:>8.1f}   static {:>8.1f}\n", stageResults[2].getMedian() / QueryCount, stageResults[3].getMedian() / QueryCount);
+        fmt::print("  {} byte window [ns]     tree {:>8.1f}   static {:>8.1f}\n\n", WindowSize, stageResults[4].getMedian() / QueryCount, stageResults[5].getMedian() / QueryCount);
+
+        std::move(stageResults.begin(), stageResults.end(), std::back_inserter(results));
+
+        return true;
+    }
+
+    // Calls the hook every evaluated node goes through from inside an evaluation, once without any breakpoints and once
+    // with a breakpoint on a line that's never reached
+    bool runHookBenchmark(const Options &options, std::vector<Result> &results) {
+        const u64 callCount = options.dataSize * 16;
+
+        pl::PatternLanguage runtime;
+        runtime.setLogCallback([](auto, const std::string &) { });
+
+        std::chrono::duration<double> duration = { };
+        runtime.addFunction({ "bench" }, "update_runtime", api::FunctionParameterCount::exactly(1), [&duration](core::Evaluator *evaluator, auto params) -> std::optional<core::Token::Literal> {
+            static const core::ast::ASTNodeLiteral node(u128(0));
+
+            const auto count = params[0].toUnsigned();
+            const auto start = Clock::now();
+            for (u128 i = 0; i < count; i++)
+                evaluator->updateRuntime(&node);
+            duration = Clock::now() - start;
+
+            return std::nullopt;
+        });
+
+        const auto sourceCode = fmt::format("bench::update_runtime({});", callCount);
+
+        std::vector<Result> stageResults;
+        for (const auto &stage : { "no_breakpoints", "unrelated_breakpoint" }) {
+            auto &evaluator = *runtime.getInternals().evaluator;
+            evaluator.clearBreakpoints();
+            if (std::string_view(stage) == "unrelated_breakpoint")
+                evaluator.addBreakpoint(100000);
+
+            Result result = { fmt::format("Hooks/{}", stage), options.dataSize, { } };
+            for (u32 i = 0; i < options.warmupIterations + options.iterations; i++) {
+                if (!runtime.executeString(sourceCode)) {
+                    fmt::print("Hook benchmark failed to execute!\n");
+                    return false;
+                }
+
+                if (i >= options.warmupIterations)
+                    result.samples.push_back(toNanoseconds(duration));
+            }
+
+            stageResults.push_back(std::move(result));
+        }
+
+        runtime.getInternals().evaluator->clearBreakpoints();
+
+        fmt::print("Hooks: {} calls per run\n", callCount);
+        fmt::print("  Per call [ns]          no breakpoints {:>8.2f}   unrelated breakpoint {:>8.2f}\n\n", stageResults[0].getMedian() / double(callCount), stageResults[1].getMedian() / double(callCount));
+
+        std::move(stageResults.begin(), stageResults.end(), std::back_inserter(results));
+
+        return true;
+    }
+
+    std::string resultsToJson(const std::vector<Result> &results, const Options &options) {
+        std::string json = fmt::format("{{\n  \"size\": {},\n  \"iterations\": {},\n  \"results\": [\n", options.dataSize, options.iterations);
+
+        // Every result is kept on a single line so baselines can be read back without a full JSON parser
+        for (size_t i = 0; i < results.size(); i++) {
+            const auto &result = results[i];
+            json += fmt::format(R"(    {{ "name": "{}", "bytes": {}, "min_ns": {:.0f}, "median_ns": {:.0f}, "mean_ns": {:.0f}, "max_ns": {:.0f} }})",
+                                result.name, result.dataSize, result.getMin(), result.getMedian(), result.getMean(), result.getMax());
+
+            if (i + 1 < results.size())
+                json += ",";
+            json += "\n";
+        }
+
+        json += "  ]\n}\n";
+
+        return json;
+    }
+
+    std::optional<std::map<std::string, double>> loadBaseline(const std::string &path) {
+        wolv::io::File file(path, wolv::io::File::Mode::Read);
+        if (!file.isValid())
+            return std::nullopt;
+
+        static const std::regex ResultRegex(R"re("name"\s*:\s*"([^"]+)".*"median_ns"\s*:\s*([0-9.eE+-]+))re");
+
+        std::map<std::string, double> medians;
+
+        const auto content = file.readString();
+        for (auto it = std::sregex_iterator(content.begin(), content.end(), ResultRegex); it != std::sregex_iterator(); ++it)
+            medians[(*it)[1].str()] = std::stod((*it)[2].str());
+
+        return medians;
+    }
+
+    void printResults(const std::vector<Result> &results) {
+        fmt::print("{:<40} {:>12} {:>12} {:>12} {:>12}\n", "Benchmark", "Median [ms]", "Min [ms]", "Mean [ms]", "MB/s");
+        for (const auto &result : results) {
+            const auto median = result.getMedian();
+            const auto throughput = median > 0 ? (double(result.dataSize) / (1024.0 * 1024.0)) / (median / 1E9) : 0.0;
+
+            fmt::print("{:<40} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.1f}\n",
+                       result.name, median / 1E6, result.getMin() / 1E6, result.getMean() / 1E6, throughput);
+        }
+    }
+
+    u32 compareToBaseline(const std::vector<Result> &results, const std::map<std::string, double> &baseline, double threshold) {
+        u32 regressions = 0;
+
+        fmt::print("\n{:<40} {:>14} {:>14} {:>10}\n", "Benchmark", "Baseline [ms]", "Current [ms]", "Change");
+        for (const auto &result : results) {
+            auto it = baseline.find(result.name);
+            if (it == baseline.end() || it->second <= 0) {
+                fmt::print("{:<40} {:>14} {:>14.3f} {:>10}\n", result.name, "-", result.getMedian() / 1E6, "new");
+                continue;
+            }
+
+            const auto change = (result.getMedian() - it->second) / it->second * 100.0;
+            const bool regressed = change > threshold;
+            if (regressed)
+                regressions += 1;
+
+            fmt::print("{:<40} {:>14.3f} {:>14.3f} {:>+9.1f}%{}\n", result.name, it->second / 1E6, result.getMedian() / 1E6, change, regressed ? "  REGRESSION" : "");
+        }
+
+        return regressions;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    ON_SCOPE_EXIT {
+        for (auto &[key, value] : BenchmarkFormat::getFormats())
+            delete value;
+    };
+
+    auto options = parseOptions(argc, argv);
+    if (!options.has_value()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::optional<std::map<std::string, double>> baseline;
+    if (!options->baselinePath.empty()) {
+        baseline = loadBaseline(options->baselinePath);
+        if (!baseline.has_value()) {
+            fmt::print("Failed to read baseline {}!\n", options->baselinePath);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Result> results;
+    for (const auto &[name, format] : BenchmarkFormat::getFormats()) {
+        if (!isSelected(*options, name))
+            continue;
+
+        if (!runBenchmark(name, *format, *options, results))
+            return EXIT_FAILURE;
+    }
+
+    if (isSelected(*options, "Index")) {
+        if (!runIndexBenchmark(*options, results))
+            return EXIT_FAILURE;
+    }
+
+    if (isSelected(*options, "Hooks")) {
+        if (!runHookBenchmark(*options, results))
+            return EXIT_FAILURE;
+    }
+
+    printResults(results);
+
+    if (!options->outputPath.empty()) {
+        wolv::io::File file(options->outputPath, wolv::io::File::Mode::Create);
+        if (!file.isValid()) {
+            fmt::print("Failed to write results to {}!\n", options->outputPath);
+            return EXIT_FAILURE;
+        }
+
+        file.writeString(resultsToJson(results, *options));
+    }
+
+    if (baseline.has_value()) {
+        const auto regressions = compareToBaseline(results, *baseline, options->threshold);
+        if (regressions > 0) {
+            fmt::print("\n{} benchmark(s) regressed by more than {}%!\n", regressions, options->threshold);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -7,7 +7,8 @@
 
 namespace pl::cli {
 
-    void executePattern(
+    // Returns false if the pattern failed, the error is left in the runtime
+    [[nodiscard]] bool executePattern(
             PatternLanguage &runtime,
             wolv::io::File &inputFilePath,
             wolv::io::File &patternFilePath,
@@ -15,4 +16,9 @@ namespace pl::cli {
             const std::vector<std::string> &defines,
             bool allowDangerousFunctions,
             u64 baseAddress);
+
+    void printLogBatch(const std::vector<core::LogConsole::Entry> &entries);
+    void printStatistics(const PatternLanguage &runtime);
+    void writeTrace(const PatternLanguage &runtime, const std::fs::path &path);
+    void printMemoryProfile(const PatternLanguage &runtime, size_t count);
 }
\ No newline at end of file
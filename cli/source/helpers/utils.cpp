@@ -2,9 +2,12 @@
 
 #include <wolv/io/file.hpp>
 
+#include <algorithm>
+#include <ranges>
+
 namespace pl::cli {
 
-    void executePattern(
+    bool executePattern(
             PatternLanguage &runtime,
             wolv::io::File &inputFile,
             wolv::io::File &patternFile,
@@ -13,7 +16,7 @@ namespace pl::cli {
             bool allowDangerousFunctions,
             u64 baseAddress) {
 
-        runtime.setDangerousFunctionCallHandler([&]() {
+        runtime.setDangerousFunctionCallHandler([allowDangerousFunctions]() {
             return allowDangerousFunctions;
         });
 
@@ -22,17 +25,115 @@ namespace pl::cli {
         for (const auto &define : defines)
             runtime.addDefine(define);
 
-        runtime.setDataSource(baseAddress, inputFile.getSize(), [&](u64 address, void *buffer, size_t size) {
-            inputFile.seek(address - baseAddress);
-            inputFile.readBuffer(static_cast<u8*>(buffer), size);
+        // The callbacks are still used after this function returned, e.g. by formatters which may read from multiple threads at once
+        runtime.setDataSource(baseAddress, inputFile.getSize(), [&inputFile, baseAddress](u64 address, void *buffer, size_t size) {
+            inputFile.readBufferAtomic(address - baseAddress, static_cast<u8*>(buffer), size);
         });
 
         // Execute pattern file
-        if (!runtime.executeString(patternFile.readString())) {
-            auto error = runtime.getError().value();
-            fmt::print("Pattern Error: {}:{} -> {}\n", error.line, error.column, error.message);
+        return runtime.executeString(patternFile.readString());
+    }
+
+    void printLogBatch(const std::vector<core::LogConsole::Entry> &entries) {
+        std::string output;
+
+        for (const auto &[level, message] : entries) {
+            switch (level) {
+                using enum pl::core::LogConsole::Level;
+
+                case Debug:
+                    output += fmt::format("[DEBUG] {}\n", message);
+                    break;
+                case Info:
+                    output += fmt::format("[INFO]  {}\n", message);
+                    break;
+                case Warning:
+                    output += fmt::format("[WARN]  {}\n", message);
+                    break;
+                case Error:
+                    output += fmt::format("[ERROR] {}\n", message);
+                    break;
+            }
+        }
+
+        // Printing the whole batch at once avoids flushing stdout for every single line
+        fmt::print("{}", output);
+    }
+
+    void printStatistics(const PatternLanguage &runtime) {
+        const auto &statistics = runtime.getStatistics();
+        const auto &timings = statistics.timings;
+
+        auto toMilliseconds = [](const core::Statistics::Duration &duration) {
+            return duration.count() * 1000.0;
+        };
+
+        fmt::print("Timings:\n");
+        fmt::print("  Preprocess: {:.3f} ms\n", toMilliseconds(timings.preprocess));
+        fmt::print("  Lex:        {:.3f} ms\n", toMilliseconds(timings.lex));
+        fmt::print("  Parse:      {:.3f} ms\n", toMilliseconds(timings.parse));
+        fmt::print("  Validate:   {:.3f} ms\n", toMilliseconds(timings.validate));
+        fmt::print("  Evaluate:   {:.3f} ms\n", toMilliseconds(timings.evaluate));
+        fmt::print("  Flatten:    {:.3f} ms\n", toMilliseconds(timings.flatten));
+
+        auto printAccess = [](const std::string &name, const core::Statistics::DataAccess &access) {
+            fmt::print("  {:<14} {} reads ({} bytes), {} writes ({} bytes)\n", name + ":", access.readCalls, access.readBytes, access.writeCalls, access.writeBytes);
+        };
+
+        fmt::print("Data Accesses:\n");
+        printAccess("Main", statistics.mainSection);
+        printAccess("Heap", statistics.heapSection);
+        printAccess("Pattern Local", statistics.patternLocalSection);
+        for (size_t id = 0; id < statistics.customSections.size(); id++) {
+            const auto &access = statistics.customSections[id];
+            if (access.readCalls != 0 || access.writeCalls != 0)
+                printAccess(fmt::format("Section {}", id), access);
+        }
+
+        fmt::print("Memory:\n");
+        fmt::print("  Heap Cell High-Water Mark:          {}\n", statistics.heapCellHighWaterMark);
+        fmt::print("  Pattern Local Slot High-Water Mark: {}\n", statistics.patternLocalSlotHighWaterMark);
+
+        fmt::print("Patterns:\n");
+        fmt::print("  Created:   {}\n", statistics.patternsCreated);
+        fmt::print("  Destroyed: {}\n", statistics.patternsDestroyed);
+        fmt::print("  Clones:    {}\n", statistics.patternClones);
+
+        fmt::print("Function Calls:\n");
+        fmt::print("  Built-in: {}\n", statistics.builtinFunctionCalls);
+        fmt::print("  Custom:   {}\n", statistics.customFunctionCalls);
+
+        fmt::print("Evaluation Errors: {}\n", statistics.evaluationErrors);
+    }
+
+    void writeTrace(const PatternLanguage &runtime, const std::fs::path &path) {
+        wolv::io::File traceFile(path, wolv::io::File::Mode::Create);
+        if (!traceFile.isValid()) {
+            fmt::print("Failed to create trace file: {}\n", path.string());
             std::exit(EXIT_FAILURE);
         }
+
+        traceFile.writeString(runtime.getTracer().toJson());
+    }
+
+    void printMemoryProfile(const PatternLanguage &runtime, size_t count) {
+        auto printConsumers = [count](const std::string &title, std::vector<core::MemoryProfiler::Consumer> consumers, bool byCount) {
+            if (byCount) {
+                std::stable_sort(consumers.begin(), consumers.end(), [](const auto &a, const auto &b) {
+                    return a.usage.getTotalCount() > b.usage.getTotalCount();
+                });
+            }
+
+            fmt::print("{}:\n", title);
+            fmt::print("  {:<32} {:>6} {:>12} {:>10} {:>12} {:>10} {:>12}\n", "Type", "Line", "Bytes", "Patterns", "Heap Bytes", "Sections", "Section Bytes");
+            for (const auto &[typeName, line, usage] : consumers | std::views::take(count)) {
+                fmt::print("  {:<32} {:>6} {:>12} {:>10} {:>12} {:>10} {:>12}\n", typeName, line, usage.getTotalBytes(), usage.patternCount, usage.heapBytes, usage.sectionCount, usage.sectionBytes);
+            }
+        };
+
+        printConsumers("Top memory consumers by bytes", runtime.getMemoryConsumers(), false);
+        printConsumers("Top memory consumers by count", runtime.getMemoryConsumers(), true);
+        printConsumers("Top memory consumers at high-water mark", runtime.getMemoryConsumers(true), false);
     }
 
 }
\ No newline at end of file
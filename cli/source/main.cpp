@@ -11,6 +11,7 @@ namespace pl::cli::sub {
     void addRunSubcommand(CLI::App *app);
     void addDocsSubcommand(CLI::App *app);
     void addInfoSubcommand(CLI::App *app);
+    void addBenchSubcommand(CLI::App *app);
 
 }
 
@@ -23,6 +24,7 @@ int main(int argc, char** argv) {
     pl::cli::sub::addRunSubcommand(&app);
     pl::cli::sub::addDocsSubcommand(&app);
     pl::cli::sub::addInfoSubcommand(&app);
+    pl::cli::sub::addBenchSubcommand(&app);
 
     // Print help message if not enough arguments were provided
     if (argc == 1) {
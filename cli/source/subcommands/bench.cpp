@@ -0,0 +1,154 @@
+#include <pl/pattern_language.hpp>
+#include <pl/patterns/pattern.hpp>
+#include <wolv/io/file.hpp>
+
+#include <CLI/CLI.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace pl::cli::sub {
+
+    namespace {
+
+        struct Samples {
+            explicit Samples(std::string name) : name(std::move(name)) { }
+
+            std::string name;
+            std::vector<double> values;
+
+            // Nearest-rank percentile
+            [[nodiscard]] double getPercentile(double percentile) const {
+                auto sorted = this->values;
+                std::sort(sorted.begin(), sorted.end());
+
+                const auto rank = size_t(std::ceil(percentile / 100.0 * double(sorted.size())));
+                return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+            }
+        };
+
+        double toMilliseconds(const core::Statistics::Duration &duration) {
+            return duration.count() * 1000.0;
+        }
+
+        // Counts the patterns a user sees in the result, including every entry of arrays
+        u64 countPatterns(ptrn::Pattern *pattern) {
+            u64 count = 1;
+            if (auto iterable = dynamic_cast<ptrn::IIterable *>(pattern); iterable != nullptr) {
+                iterable->forEachEntry(0, iterable->getEntryCount(), [&count](u64, ptrn::Pattern *entry) {
+                    count += countPatterns(entry);
+                });
+            }
+
+            return count;
+        }
+
+    }
+
+    void addBenchSubcommand(CLI::App *app) {
+        static std::vector<std::fs::path> includePaths;
+
+        static bool allowDangerousFunctions = false;
+        static u64 baseAddress = 0x00;
+        static u32 iterations = 10;
+        static u32 warmupIterations = 1;
+        static std::vector<std::string> defines;
+
+        static std::fs::path inputFilePath, patternFilePath;
+
+        auto subcommand = app->add_subcommand("bench");
+
+        // Add command line arguments
+        subcommand->add_option("-i,--input,INPUT_FILE", inputFilePath, "Input file")->required()->check(CLI::ExistingFile);
+        subcommand->add_option("-p,--pattern,PATTERN_FILE", patternFilePath, "Pattern file")->required()->check(CLI::ExistingFile);
+        subcommand->add_option("-I,--includes", includePaths, "Include file paths")->take_all()->check(CLI::ExistingDirectory);
+        subcommand->add_option("-b,--base", baseAddress, "Base address")->default_val(0x00);
+        subcommand->add_option("-D,--define", defines, "Define a preprocessor macro")->take_all();
+        subcommand->add_option("-n,--iterations", iterations, "Number of measured runs")->default_val(10);
+        subcommand->add_option("-w,--warmup", warmupIterations, "Number of discarded runs before measuring")->default_val(1);
+        subcommand->add_flag("-d,--dangerous", allowDangerousFunctions, "Allow dangerous functions")->default_val(false);
+
+        subcommand->callback([] {
+            if (iterations == 0) {
+                fmt::print("At least one iteration is required\n");
+                std::exit(EXIT_FAILURE);
+            }
+
+            // Create and configure Pattern Language runtime
+            pl::PatternLanguage runtime;
+            runtime.setDangerousFunctionCallHandler([&]() {
+                return allowDangerousFunctions;
+            });
+
+            runtime.addPragma("MIME", [](auto&, const auto&){ return true; });
+
+            for (const auto &define : defines)
+                runtime.addDefine(define);
+
+            runtime.setIncludePaths(includePaths);
+
+            // Data is read on demand so inputs larger than the available memory can be benchmarked
+            wolv::io::File inputFile(inputFilePath, wolv::io::File::Mode::Read);
+            const auto inputSize = inputFile.getSize();
+            runtime.setDataSource(baseAddress, inputSize, [&](u64 address, void *buffer, size_t size) {
+                inputFile.seek(address - baseAddress);
+                inputFile.readBuffer(static_cast<u8*>(buffer), size);
+            });
+
+            const auto patternCode = wolv::io::File(patternFilePath, wolv::io::File::Mode::Read).readString();
+
+            Samples total("Total"), preprocess("Preprocess"), lex("Lex"), parse("Parse"), validate("Validate"), evaluate("Evaluate"), flatten("Flatten");
+            u64 patternCount = 0;
+
+            for (u32 i = 0; i < warmupIterations + iterations; i++) {
+                const auto start = std::chrono::steady_clock::now();
+                const bool success = runtime.executeString(patternCode);
+                const auto end = std::chrono::steady_clock::now();
+
+                if (!success) {
+                    auto error = runtime.getError().value();
+                    fmt::print("Pattern Error: {}:{} -> {}\n", error.line, error.column, error.message);
+                    std::exit(EXIT_FAILURE);
+                }
+
+                if (i < warmupIterations)
+                    continue;
+
+                const auto &statistics = runtime.getStatistics();
+                const auto &timings = statistics.timings;
+
+                total.values.push_back(toMilliseconds(end - start));
+                preprocess.values.push_back(toMilliseconds(timings.preprocess));
+                lex.values.push_back(toMilliseconds(timings.lex));
+                parse.values.push_back(toMilliseconds(timings.parse));
+                validate.values.push_back(toMilliseconds(timings.validate));
+                evaluate.values.push_back(toMilliseconds(timings.evaluate));
+                flatten.values.push_back(toMilliseconds(timings.flatten));
+
+            }
+
+            for (const auto &pattern : runtime.getPatterns())
+                patternCount += countPatterns(pattern.get());
+
+            fmt::print("Input:    {} bytes\n", inputSize);
+            fmt::print("Runs:     {} ({} warmup)\n", iterations, warmupIterations);
+            fmt::print("Patterns: {} in the result\n\n", patternCount);
+
+            fmt::print("{:<12} {:>12} {:>12} {:>12} {:>12} {:>12}\n", "Phase [ms]", "Min", "P50", "P90", "P99", "Max");
+            for (const auto *samples : { &total, &preprocess, &lex, &parse, &validate, &evaluate, &flatten }) {
+                fmt::print("{:<12} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}\n",
+                           samples->name, samples->getPercentile(0), samples->getPercentile(50), samples->getPercentile(90), samples->getPercentile(99), samples->getPercentile(100));
+            }
+
+            const auto medianSeconds = total.getPercentile(50) / 1000.0;
+            if (medianSeconds > 0) {
+                fmt::print("\nThroughput (median run):\n");
+                fmt::print("  {:.2f} MB/s\n", (double(inputSize) / (1024.0 * 1024.0)) / medianSeconds);
+                fmt::print("  {:.0f} patterns/s\n", double(patternCount) / medianSeconds);
+            }
+        });
+    }
+
+}
@@ -12,7 +12,7 @@ namespace pl::cli::sub {
     void addFormatSubcommand(CLI::App *app) {
         static const auto formatters = pl::gen::fmt::createFormatters();
 
-        static std::fs::path inputFilePath, outputFilePath, patternFilePath;
+        static std::fs::path inputFilePath, outputFilePath, patternFilePath, traceFilePath;
         static std::vector<std::fs::path> includePaths;
         static std::vector<std::string> defines;
 
@@ -20,7 +20,12 @@ namespace pl::cli::sub {
         static bool verbose = false;
         static bool allowDangerousFunctions = false;
         static bool metaInformation = false;
+        static bool showStatistics = false;
+        static bool showMemoryProfile = false;
         static u64 baseAddress = 0x00;
+        static u32 threadCount = 1;
+        static u64 htmlPageSize = 0x10000;
+        static u64 htmlMaxSize = 0x1000000;
 
         auto subcommand = app->add_subcommand("format");
 
@@ -34,6 +39,12 @@ namespace pl::cli::sub {
         subcommand->add_flag("-v,--verbose", verbose, "Verbose output")->default_val(false);
         subcommand->add_flag("-d,--dangerous", allowDangerousFunctions, "Allow dangerous functions")->default_val(false);
         subcommand->add_flag("-m,--metadata", metaInformation, "Include meta type information")->default_val(0x00);
+        subcommand->add_flag("-s,--stats", showStatistics, "Print execution statistics")->default_val(false);
+        subcommand->add_option("-t,--trace", traceFilePath, "Write a trace event file of the execution");
+        subcommand->add_option("-j,--threads", threadCount, "Number of threads to format with, 0 uses all cores")->default_val(1);
+        subcommand->add_option("--html-page-size", htmlPageSize, "Number of bytes per page of the html formatter")->default_val(0x10000);
+        subcommand->add_option("--html-max-size", htmlMaxSize, "Number of bytes included by the html formatter, 0 includes everything")->default_val(0x1000000);
+        subcommand->add_flag("-M,--memory-profile", showMemoryProfile, "Print the types responsible for the most memory usage")->default_val(false);
         subcommand->add_option("-f,--formatter", formatterName, "Formatter")->default_val("default")->check([&](const auto &value) -> std::string {
             // Validate if the selected formatter exists
             if (std::any_of(formatters.begin(), formatters.end(), [&](const auto &formatter) { return formatter->getName() == value; }))
@@ -81,44 +92,61 @@ namespace pl::cli::sub {
             // Create and configure Pattern Language runtime
             pl::PatternLanguage runtime;
 
-            runtime.setLogCallback([](auto level, const auto &message) {
-                if (!verbose)
-                    return;
-
-                switch (level) {
-                    using enum pl::core::LogConsole::Level;
-
-                    case Debug:
-                        ::fmt::print("[DEBUG] {}\n", message);
-                        break;
-                    case Info:
-                        ::fmt::print("[INFO]  {}\n", message);
-                        break;
-                    case Warning:
-                        ::fmt::print("[WARN]  {}\n", message);
-                        break;
-                    case Error:
-                        ::fmt::print("[ERROR] {}\n", message);
-                        break;
-                }
-            });
+            if (verbose) {
+                runtime.setLogBatchCallback(pl::cli::printLogBatch);
+                runtime.setLogBuffering(4096, true);
+            }
+
+            runtime.setTracingEnabled(!traceFilePath.empty());
+            runtime.setMemoryProfilingEnabled(showMemoryProfile);
+
+            auto printDiagnostics = [&runtime] {
+                if (showStatistics)
+                    pl::cli::printStatistics(runtime);
 
-            pl::cli::executePattern(runtime, inputFile, patternFile, includePaths, defines, allowDangerousFunctions, baseAddress);
+                if (showMemoryProfile)
+                    pl::cli::printMemoryProfile(runtime, 10);
+
+                if (!traceFilePath.empty())
+                    pl::cli::writeTrace(runtime, traceFilePath);
+            };
+
+            if (!pl::cli::executePattern(runtime, inputFile, patternFile, includePaths, defines, allowDangerousFunctions, baseAddress)) {
+                printDiagnostics();
+
+                auto error = runtime.getError().value();
+                ::fmt::print("Pattern Error: {}:{} -> {}\n", error.line, error.column, error.message);
+                std::exit(EXIT_FAILURE);
+            }
 
             // Set formatter settings
             formatter->enableMetaInformation(metaInformation);
+            formatter->setThreadCount(threadCount);
 
-            // Call selected formatter to format the results
-            auto result = formatter->format(runtime);
+            if (auto htmlFormatter = dynamic_cast<pl::gen::fmt::FormatterHtml *>(formatter.get()); htmlFormatter != nullptr) {
+                htmlFormatter->setPageSize(htmlPageSize);
+                htmlFormatter->setMaxSize(htmlMaxSize);
+            }
 
-            // Write results to output file
+            if (!formatter->canFormat(runtime)) {
+                ::fmt::print("Formatter '{}' found nothing to export in the patterns\n", formatter->getName());
+                std::exit(EXIT_FAILURE);
+            }
+
+            // Open output file
             wolv::io::File outputFile(outputFilePath, wolv::io::File::Mode::Create);
             if (!outputFile.isValid()) {
                 ::fmt::print("Failed to create output file: {}\n", outputFilePath.string());
                 std::exit(EXIT_FAILURE);
             }
 
-            outputFile.writeVector(result);
+            // Call selected formatter and write the results to the output file as they're generated
+            pl::gen::fmt::OutputSink sink([&outputFile](const u8 *data, size_t size) {
+                outputFile.writeBuffer(data, size);
+            });
+            formatter->formatTo(runtime, sink);
+
+            printDiagnostics();
         });
     }
 
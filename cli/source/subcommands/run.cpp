@@ -2,6 +2,8 @@
 #include <pl/formatters.hpp>
 #include <wolv/io/file.hpp>
 
+#include <cli/helpers/utils.hpp>
+
 #include <CLI/CLI.hpp>
 #include <fmt/format.h>
 
@@ -13,10 +15,12 @@ namespace pl::cli::sub {
         static std::string formatterName;
         static bool verbose = false;
         static bool allowDangerousFunctions = false;
+        static bool showStatistics = false;
+        static bool showMemoryProfile = false;
         static u64 baseAddress = 0x00;
         static std::vector<std::string> defines;
 
-        static std::fs::path inputFilePath, patternFilePath;
+        static std::fs::path inputFilePath, patternFilePath, traceFilePath;
 
         auto subcommand = app->add_subcommand("run");
 
@@ -28,6 +32,9 @@ namespace pl::cli::sub {
         subcommand->add_option("-D,--define", defines, "Define a preprocessor macro")->take_all();
         subcommand->add_flag("-v,--verbose", verbose, "Verbose output")->default_val(false);
         subcommand->add_flag("-d,--dangerous", allowDangerousFunctions, "Allow dangerous functions")->default_val(false);
+        subcommand->add_flag("-s,--stats", showStatistics, "Print execution statistics")->default_val(false);
+        subcommand->add_option("-t,--trace", traceFilePath, "Write a trace event file of the execution");
+        subcommand->add_flag("-M,--memory-profile", showMemoryProfile, "Print the types responsible for the most memory usage")->default_val(false);
 
         subcommand->callback([] {
 
@@ -52,30 +59,27 @@ namespace pl::cli::sub {
                     std::memcpy(buffer, data.data() + address, size);
             });
 
-            runtime.setLogCallback([](auto level, const std::string &message) {
-                if (!verbose)
-                    return;
-
-                switch (level) {
-                    using enum pl::core::LogConsole::Level;
-
-                    case Debug:
-                        ::fmt::print("[DEBUG] {}\n", message);
-                        break;
-                    case Info:
-                        ::fmt::print("[INFO]  {}\n", message);
-                        break;
-                    case Warning:
-                        ::fmt::print("[WARN]  {}\n", message);
-                        break;
-                    case Error:
-                        ::fmt::print("[ERROR] {}\n", message);
-                        break;
-                }
-            });
+            if (verbose) {
+                runtime.setLogBatchCallback(pl::cli::printLogBatch);
+                runtime.setLogBuffering(4096, true);
+            }
+
+            runtime.setTracingEnabled(!traceFilePath.empty());
+            runtime.setMemoryProfilingEnabled(showMemoryProfile);
 
             // Execute pattern file
-            if (!runtime.executeFile(patternFilePath)) {
+            bool success = runtime.executeFile(patternFilePath);
+
+            if (showStatistics)
+                pl::cli::printStatistics(runtime);
+
+            if (showMemoryProfile)
+                pl::cli::printMemoryProfile(runtime, 10);
+
+            if (!traceFilePath.empty())
+                pl::cli::writeTrace(runtime, traceFilePath);
+
+            if (!success) {
                 auto error = runtime.getError().value();
                 fmt::print("Pattern Error: {}:{} -> {}\n", error.line, error.column, error.message);
                 std::exit(EXIT_FAILURE);
@@ -21,8 +21,13 @@
 #include <pl/patterns/pattern_wide_character.hpp>
 #include <pl/patterns/pattern_wide_string.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace pl::gen::fmt {
 
@@ -48,10 +53,105 @@ namespace pl::gen::fmt {
             return result;
         }
 
+        // Encoding of the entries of a static array of plain values without formatter functions.
+        // These arrays are decoded in bulk instead of visiting every single entry
+        [[nodiscard]] static std::optional<hlp::ValueEncoding> getBulkEncoding(ptrn::Pattern *pattern) {
+            auto array = dynamic_cast<ptrn::PatternArrayStatic *>(pattern);
+            if (array == nullptr || array->getTemplate() == nullptr)
+                return std::nullopt;
+
+            const auto &entry = array->getTemplate();
+            if (entry->isSealed() || !entry->getReadFormatterFunction().empty())
+                return std::nullopt;
+
+            return array->getEntryEncoding();
+        }
+
+        // Decodes the values of the entries [start, end) of an array with a bulk encoding in chunks
+        template<typename T>
+        static void forEachValueChunk(ptrn::Pattern *pattern, u64 start, u64 end, const std::function<void(std::span<const T> values)> &callback) {
+            auto array = dynamic_cast<ptrn::PatternArrayStatic *>(pattern);
+            end = std::min<u64>(end, array->getEntryCount());
+
+            auto buffer = std::make_unique<T[]>(ValueChunkSize);
+            for (u64 chunkStart = start; chunkStart < end; chunkStart += ValueChunkSize) {
+                const auto values = std::span(buffer.get(), std::min<u64>(ValueChunkSize, end - chunkStart));
+                array->readValues(chunkStart, values);
+
+                callback(values);
+            }
+        }
+
     private:
+        constexpr static u64 ValueChunkSize = 0x1000;
+
         bool m_metaInformation = false;
     };
 
+    // Destination of formatter output. Everything written is collected in a fixed size buffer
+    // and handed to the callback in chunks of at most that size
+    class OutputSink {
+    public:
+        using Callback = std::function<void(const u8 *data, size_t size)>;
+
+        explicit OutputSink(Callback callback, size_t bufferSize = 64 * 1024) : m_callback(std::move(callback)) {
+            this->m_buffer.reserve(bufferSize);
+        }
+
+        OutputSink(const OutputSink &) = delete;
+        OutputSink(OutputSink &&) = delete;
+
+        void write(const u8 *data, size_t size) {
+            if (this->m_buffer.size() + size > this->m_buffer.capacity()) {
+                this->flush();
+
+                // Data that doesn't fit into the buffer anyways is passed on directly
+                if (size >= this->m_buffer.capacity()) {
+                    this->m_callback(data, size);
+                    this->m_bytesWritten += size;
+                    return;
+                }
+            }
+
+            this->m_buffer.insert(this->m_buffer.end(), data, data + size);
+            this->m_bytesWritten += size;
+        }
+
+        void write(std::string_view string) {
+            this->write(reinterpret_cast<const u8 *>(string.data()), string.size());
+        }
+
+        void write(char c) {
+            if (this->m_buffer.size() == this->m_buffer.capacity())
+                this->flush();
+
+            this->m_buffer.push_back(u8(c));
+            this->m_bytesWritten += 1;
+        }
+
+        void write(size_t count, char c) {
+            for (size_t i = 0; i < count; i++)
+                this->write(c);
+        }
+
+        void flush() {
+            if (this->m_buffer.empty())
+                return;
+
+            this->m_callback(this->m_buffer.data(), this->m_buffer.size());
+            this->m_buffer.clear();
+        }
+
+        [[nodiscard]] u64 getBytesWritten() const {
+            return this->m_bytesWritten;
+        }
+
+    private:
+        Callback m_callback;
+        std::vector<u8> m_buffer;
+        u64 m_bytesWritten = 0;
+    };
+
     class Formatter {
     public:
         explicit Formatter(std::string name) : m_name(std::move(name)) { }
@@ -64,12 +164,54 @@ namespace pl::gen::fmt {
         [[nodiscard]] virtual std::string getFileExtension() const = 0;
         [[nodiscard]] virtual std::vector<u8> format(const PatternLanguage &runtime) = 0;
 
+        // Whether the patterns of the runtime contain anything this formatter can export
+        [[nodiscard]] virtual bool canFormat([[maybe_unused]] const PatternLanguage &runtime) const {
+            return true;
+        }
+
+        // Formatters that generate their whole output in memory first simply pass it on to the sink
+        virtual void formatTo(const PatternLanguage &runtime, OutputSink &sink) {
+            const auto result = this->format(runtime);
+            sink.write(result.data(), result.size());
+            sink.flush();
+        }
+
         void enableMetaInformation(bool enable) { this->m_metaInformation = enable; }
         [[nodiscard]] bool isMetaInformationEnabled() const { return this->m_metaInformation; }
 
+        // Formatters that support it split their work over this many threads. 0 uses all available cores
+        void setThreadCount(u32 threadCount) { this->m_threadCount = threadCount; }
+        [[nodiscard]] u32 getThreadCount() const {
+            if (this->m_threadCount == 0)
+                return std::max<u32>(std::thread::hardware_concurrency(), 1);
+            else
+                return this->m_threadCount;
+        }
+
     private:
         std::string m_name;
         bool m_metaInformation = false;
+        u32 m_threadCount = 1;
+    };
+
+    // Base of formatters that write their output to the sink while it's being generated so
+    // their memory usage doesn't depend on the size of the output
+    class StreamingFormatter : public Formatter {
+    public:
+        using Formatter::Formatter;
+
+        [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) final {
+            std::vector<u8> result;
+
+            OutputSink sink([&result](const u8 *data, size_t size) {
+                result.insert(result.end(), data, data + size);
+            });
+            this->formatTo(runtime, sink);
+
+            return result;
+        }
+
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override = 0;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,502 @@
+#include <pl/formatters/formatter.hpp>
+#include <pl/formatters/parallel_driver.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace pl::gen::fmt {
+
+    /*
+     * Minimal CBOR (RFC 8949) encoder writing straight into an output sink.
+     * Arrays and maps are encoded with indefinite length so they can be written before the number of their
+     * entries is known. Integers that don't fit into 64 bits are written as bignums and floats use the
+     * smallest encoding that represents them exactly.
+     */
+    class CborEncoder {
+    public:
+        explicit CborEncoder(OutputSink &sink) : m_sink(sink) { }
+
+        void writeUnsigned(u128 value) {
+            if (value <= std::numeric_limits<u64>::max())
+                this->writeHead(MajorType::Unsigned, u64(value));
+            else
+                this->writeBigNum(TagPositiveBigNum, value);
+        }
+
+        void writeSigned(i128 value) {
+            if (value >= 0) {
+                this->writeUnsigned(u128(value));
+                return;
+            }
+
+            // Negative integers are stored as -1 - n
+            const auto argument = u128(-(value + 1));
+            if (argument <= std::numeric_limits<u64>::max())
+                this->writeHead(MajorType::Negative, u64(argument));
+            else
+                this->writeBigNum(TagNegativeBigNum, argument);
+        }
+
+        void writeFloat(double value) {
+            if (std::isnan(value)) {
+                this->writeRaw({ 0xF9, 0x7E, 0x00 });
+            } else if (double(float(value)) == value) {
+                u32 bits = 0;
+                const float single = float(value);
+                std::memcpy(&bits, &single, sizeof(bits));
+
+                this->m_sink.write(char(0xFA));
+                this->writeBigEndian(bits, sizeof(bits));
+            } else {
+                u64 bits = 0;
+                std::memcpy(&bits, &value, sizeof(bits));
+
+                this->m_sink.write(char(0xFB));
+                this->writeBigEndian(bits, sizeof(bits));
+            }
+        }
+
+        void writeBoolean(bool value) {
+            this->m_sink.write(char(value ? 0xF5 : 0xF4));
+        }
+
+        void writeNull() {
+            this->m_sink.write(char(0xF6));
+        }
+
+        // Strings that aren't valid UTF-8 can't be stored as text and are written as byte strings instead
+        void writeString(std::string_view string) {
+            this->writeHead(isValidUtf8(string) ? MajorType::TextString : MajorType::ByteString, string.size());
+            this->m_sink.write(string);
+        }
+
+        void writeBytes(const u8 *data, size_t size) {
+            this->beginBytes(size);
+            this->m_sink.write(data, size);
+        }
+
+        // Starts a byte string of the given size. Its content needs to be written using writeRaw() afterwards
+        void beginBytes(u64 size) {
+            this->writeHead(MajorType::ByteString, size);
+        }
+
+        void writeRaw(const u8 *data, size_t size) {
+            this->m_sink.write(data, size);
+        }
+
+        void beginArray() {
+            this->m_sink.write(char(0x9F));
+        }
+
+        void beginMap() {
+            this->m_sink.write(char(0xBF));
+        }
+
+        void endContainer() {
+            this->m_sink.write(char(0xFF));
+        }
+
+    private:
+        enum class MajorType : u8 {
+            Unsigned    = 0,
+            Negative    = 1,
+            ByteString  = 2,
+            TextString  = 3,
+            Array       = 4,
+            Map         = 5,
+            Tag         = 6
+        };
+
+        constexpr static u64 TagPositiveBigNum = 2;
+        constexpr static u64 TagNegativeBigNum = 3;
+
+        void writeRaw(std::initializer_list<u8> bytes) {
+            this->m_sink.write(bytes.begin(), bytes.size());
+        }
+
+        void writeBigEndian(u64 value, size_t size) {
+            std::array<u8, sizeof(u64)> bytes = { };
+            for (size_t i = 0; i < size; i++)
+                bytes[i] = u8(value >> ((size - i - 1) * 8));
+
+            this->m_sink.write(bytes.data(), size);
+        }
+
+        void writeHead(MajorType type, u64 argument) {
+            const u8 major = u8(type) << 5;
+
+            if (argument < 24) {
+                this->m_sink.write(char(major | argument));
+            } else if (argument <= std::numeric_limits<u8>::max()) {
+                this->m_sink.write(char(major | 24));
+                this->writeBigEndian(argument, 1);
+            } else if (argument <= std::numeric_limits<u16>::max()) {
+                this->m_sink.write(char(major | 25));
+                this->writeBigEndian(argument, 2);
+            } else if (argument <= std::numeric_limits<u32>::max()) {
+                this->m_sink.write(char(major | 26));
+                this->writeBigEndian(argument, 4);
+            } else {
+                this->m_sink.write(char(major | 27));
+                this->writeBigEndian(argument, 8);
+            }
+        }
+
+        void writeBigNum(u64 tag, u128 value) {
+            std::array<u8, sizeof(u128)> bytes = { };
+            size_t size = 0;
+            for (; value != 0; value >>= 8)
+                bytes[bytes.size() - ++size] = u8(value);
+
+            this->writeHead(MajorType::Tag, tag);
+            this->writeBytes(bytes.data() + bytes.size() - size, size);
+        }
+
+        static bool isValidUtf8(std::string_view string) {
+            for (size_t i = 0; i < string.size();) {
+                const auto c = u8(string[i]);
+
+                size_t length;
+                if (c < 0x80)                   length = 1;
+                else if ((c & 0xE0) == 0xC0)    length = 2;
+                else if ((c & 0xF0) == 0xE0)    length = 3;
+                else if ((c & 0xF8) == 0xF0)    length = 4;
+                else                            return false;
+
+                if (i + length > string.size())
+                    return false;
+
+                u32 codePoint = length == 1 ? c : c & (0xFF >> (length + 1));
+                for (size_t j = 1; j < length; j++) {
+                    const auto continuation = u8(string[i + j]);
+                    if ((continuation & 0xC0) != 0x80)
+                        return false;
+
+                    codePoint = (codePoint << 6) | (continuation & 0x3F);
+                }
+
+                // Reject overlong encodings, surrogates and code points past the Unicode range
+                constexpr static std::array<u32, 5> MinCodePoint = { 0, 0x00, 0x80, 0x800, 0x10000 };
+                if (codePoint < MinCodePoint[length] || (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
+                    return false;
+
+                i += length;
+            }
+
+            return true;
+        }
+
+    private:
+        OutputSink &m_sink;
+    };
+
+    class CborPatternVisitor : public FormatterPatternVisitor {
+    public:
+        explicit CborPatternVisitor(OutputSink &sink) : m_encoder(sink) { }
+
+        void visit(pl::ptrn::PatternArrayDynamic& pattern)  override { formatArray(&pattern);       }
+        void visit(pl::ptrn::PatternArrayStatic& pattern)   override { formatArray(&pattern);       }
+        void visit(pl::ptrn::PatternBitfieldField& pattern) override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternBitfieldArray& pattern) override { formatArray(&pattern);       }
+        void visit(pl::ptrn::PatternBitfield& pattern)      override { formatObject(&pattern);      }
+        void visit(pl::ptrn::PatternBoolean& pattern)       override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternCharacter& pattern)     override { formatString(&pattern);      }
+        void visit(pl::ptrn::PatternEnum& pattern)          override { formatString(&pattern);      }
+        void visit(pl::ptrn::PatternFloat& pattern)         override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternPadding& pattern)       override { wolv::util::unused(pattern); }
+        void visit(pl::ptrn::PatternPointer& pattern)       override { formatPointer(&pattern);     }
+        void visit(pl::ptrn::PatternSigned& pattern)        override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternString& pattern)        override { formatString(&pattern);      }
+        void visit(pl::ptrn::PatternStruct& pattern)        override { formatObject(&pattern);      }
+        void visit(pl::ptrn::PatternUnion& pattern)         override { formatObject(&pattern);      }
+        void visit(pl::ptrn::PatternUnsigned& pattern)      override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternWideCharacter& pattern) override { formatString(&pattern);      }
+        void visit(pl::ptrn::PatternWideString& pattern)    override { formatString(&pattern);      }
+
+        void beginArray(pl::ptrn::Pattern *pattern) {
+            writeKey(pattern);
+            this->m_encoder.beginArray();
+        }
+
+        void formatArrayEntry(pl::ptrn::Pattern *entry) {
+            this->m_inArray = true;
+            entry->accept(*this);
+        }
+
+        // Encodes the entries [start, end) of arrays of plain values straight from their decoded values.
+        // Returns false if the entries need to be visited instead
+        bool formatArrayValues(pl::ptrn::Pattern *pattern, u64 start, u64 end) {
+            const auto encoding = getBulkEncoding(pattern);
+            if (!encoding.has_value())
+                return false;
+
+            switch (encoding->type) {
+                using enum hlp::ValueEncoding::Type;
+                case Unsigned:
+                    forEachValueChunk<u64>(pattern, start, end, [this](std::span<const u64> values) {
+                        for (const auto value : values)
+                            this->m_encoder.writeUnsigned(value);
+                    });
+                    return true;
+                case Signed:
+                    forEachValueChunk<i64>(pattern, start, end, [this](std::span<const i64> values) {
+                        for (const auto value : values)
+                            this->m_encoder.writeSigned(value);
+                    });
+                    return true;
+                case Float:
+                    forEachValueChunk<double>(pattern, start, end, [this](std::span<const double> values) {
+                        for (const auto value : values)
+                            this->m_encoder.writeFloat(value);
+                    });
+                    return true;
+                case Boolean:
+                    forEachValueChunk<bool>(pattern, start, end, [this](std::span<const bool> values) {
+                        for (const auto value : values)
+                            this->m_encoder.writeBoolean(value);
+                    });
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        void endArray() {
+            this->m_encoder.endContainer();
+            this->m_inArray = false;
+        }
+
+        // Arrays of plain bytes are written as a single byte string instead of one integer per entry
+        [[nodiscard]] static bool isByteArray(pl::ptrn::Pattern *pattern) {
+            if (auto staticArray = dynamic_cast<ptrn::PatternArrayStatic *>(pattern); staticArray != nullptr)
+                return isByteEntry(staticArray->getTemplate().get());
+
+            if (auto dynamicArray = dynamic_cast<ptrn::PatternArrayDynamic *>(pattern); dynamicArray != nullptr) {
+                if (dynamicArray->getEntryCount() == 0)
+                    return false;
+
+                bool result = true;
+                dynamicArray->forEachEntry(0, dynamicArray->getEntryCount(), [&](u64, ptrn::Pattern *entry) {
+                    result = result && isByteEntry(entry);
+                });
+
+                return result;
+            }
+
+            return false;
+        }
+
+    private:
+        // Entries of arrays don't have a key, everything else is an entry of the surrounding map
+        void writeKey(pl::ptrn::Pattern *pattern) {
+            if (!this->m_inArray)
+                this->m_encoder.writeString(pattern->getVariableName());
+
+            this->m_inArray = false;
+        }
+
+        [[nodiscard]] static bool isByteEntry(pl::ptrn::Pattern *pattern) {
+            return dynamic_cast<ptrn::PatternUnsigned *>(pattern) != nullptr && pattern->getSize() == 1 && !pattern->isSealed() &&
+                   pattern->getTransformFunction().empty() && pattern->getReadFormatterFunction().empty();
+        }
+
+        void formatLiteral(const core::Token::Literal &literal) {
+            std::visit(wolv::util::overloaded {
+                    [&](char value)                                 { this->m_encoder.writeString(std::string(1, value)); },
+                    [&](bool value)                                 { this->m_encoder.writeBoolean(value); },
+                    [&](u128 value)                                 { this->m_encoder.writeUnsigned(value); },
+                    [&](i128 value)                                 { this->m_encoder.writeSigned(value); },
+                    [&](double value)                               { this->m_encoder.writeFloat(value); },
+                    [&](const std::string &value)                   { this->m_encoder.writeString(value); },
+                    [&](const std::shared_ptr<ptrn::Pattern> &value) { this->m_encoder.writeString(value->toString()); }
+            }, literal);
+        }
+
+        void formatString(pl::ptrn::Pattern *pattern) {
+            writeKey(pattern);
+            this->m_encoder.writeString(pattern->toString());
+        }
+
+        void formatBytes(pl::ptrn::Pattern *pattern) {
+            auto array = dynamic_cast<ptrn::IIterable *>(pattern);
+            const auto size = array->getEntryCount();
+
+            writeKey(pattern);
+            this->m_encoder.beginBytes(size);
+
+            std::array<u8, 0x1000> buffer = { };
+            if (dynamic_cast<ptrn::PatternArrayStatic *>(pattern) != nullptr) {
+                // Entries of static arrays are laid out back to back so they can be read in one go
+                for (u64 offset = 0; offset < size; offset += buffer.size()) {
+                    const auto chunkSize = std::min<u64>(buffer.size(), size - offset);
+                    pattern->getEvaluator()->readData(pattern->getOffset() + offset, buffer.data(), chunkSize, pattern->getSection());
+                    this->m_encoder.writeRaw(buffer.data(), chunkSize);
+                }
+            } else {
+                size_t bufferSize = 0;
+                array->forEachEntry(0, size, [&](u64, ptrn::Pattern *entry) {
+                    buffer[bufferSize++] = u8(entry->getValue().toUnsigned());
+                    if (bufferSize == buffer.size()) {
+                        this->m_encoder.writeRaw(buffer.data(), bufferSize);
+                        bufferSize = 0;
+                    }
+                });
+                this->m_encoder.writeRaw(buffer.data(), bufferSize);
+            }
+        }
+
+        template<typename T>
+        void formatArray(T *pattern) {
+            if (isByteArray(pattern)) {
+                formatBytes(pattern);
+                return;
+            }
+
+            beginArray(pattern);
+            if (!formatArrayValues(pattern, 0, pattern->getEntryCount())) {
+                pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                    formatArrayEntry(member);
+                });
+            }
+            endArray();
+        }
+
+        void formatPointer(ptrn::PatternPointer *pattern) {
+            writeKey(pattern);
+            this->m_encoder.beginMap();
+            pattern->getPointedAtPattern()->accept(*this);
+            this->m_encoder.endContainer();
+        }
+
+        void formatMetaInformation(ptrn::Pattern *pattern) {
+            if (!this->isMetaInformationEnabled())
+                return;
+
+            this->m_encoder.writeString("__type");
+            this->m_encoder.writeString(pattern->getTypeName());
+            this->m_encoder.writeString("__address");
+            this->m_encoder.writeUnsigned(pattern->getOffset());
+            this->m_encoder.writeString("__size");
+            this->m_encoder.writeUnsigned(pattern->getSize());
+            this->m_encoder.writeString("__color");
+            this->m_encoder.writeUnsigned(pattern->getColor());
+            this->m_encoder.writeString("__endian");
+            this->m_encoder.writeString(pattern->getEndian() == std::endian::little ? "little" : "big");
+            if (const auto &comment = pattern->getComment(); !comment.empty()) {
+                this->m_encoder.writeString("__comment");
+                this->m_encoder.writeString(comment);
+            }
+        }
+
+        template<typename T>
+        void formatObject(T *pattern) {
+            if (pattern->isSealed()) {
+                formatValue(pattern);
+            } else {
+                writeKey(pattern);
+                this->m_encoder.beginMap();
+
+                formatMetaInformation(pattern);
+
+                pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                    member->accept(*this);
+                });
+                this->m_encoder.endContainer();
+            }
+        }
+
+        void formatValue(pl::ptrn::Pattern *pattern) {
+            if (auto functionName = pattern->getReadFormatterFunction(); !functionName.empty())
+                formatString(pattern);
+            else if (!pattern->isSealed()) {
+                writeKey(pattern);
+                formatLiteral(pattern->getValue());
+            }
+        }
+
+    private:
+        CborEncoder m_encoder;
+        bool m_inArray = false;
+    };
+
+    class FormatterCbor : public StreamingFormatter {
+    public:
+        FormatterCbor() : StreamingFormatter("cbor") { }
+        ~FormatterCbor() override = default;
+
+        [[nodiscard]] std::string getFileExtension() const override { return "cbor"; }
+
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override {
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            CborEncoder encoder(sink);
+            encoder.beginMap();
+
+            if (this->getThreadCount() > 1) {
+                formatParallel(runtime, sink);
+            } else {
+                auto visitor = this->createVisitor(sink);
+                for (const auto& pattern : runtime.getPatterns()) {
+                    pattern->accept(visitor);
+                }
+            }
+
+            encoder.endContainer();
+            sink.flush();
+        }
+
+    private:
+        [[nodiscard]] CborPatternVisitor createVisitor(OutputSink &sink) const {
+            CborPatternVisitor visitor(sink);
+            visitor.enableMetaInformation(this->isMetaInformationEnabled());
+
+            return visitor;
+        }
+
+        // Containers don't store their size so chunks can simply be written one after another
+        void formatParallel(const PatternLanguage &runtime, OutputSink &sink) {
+            ParallelDriver driver(runtime, this->getThreadCount());
+
+            for (const auto &pattern : runtime.getPatterns()) {
+                auto array = ParallelDriver::getSplittableArray(pattern.get());
+                if (array == nullptr || CborPatternVisitor::isByteArray(pattern.get())) {
+                    driver.addJob([this, pattern = pattern.get()](OutputSink &chunk) {
+                        auto visitor = this->createVisitor(chunk);
+                        pattern->accept(visitor);
+                    });
+
+                    continue;
+                }
+
+                driver.addJob([this, pattern = pattern.get()](OutputSink &chunk) {
+                    auto visitor = this->createVisitor(chunk);
+                    visitor.beginArray(pattern);
+                });
+
+                for (u64 start = 0; start < array->getEntryCount(); start += ParallelDriver::ArrayRangeSize) {
+                    driver.addJob([this, pattern = pattern.get(), start](OutputSink &chunk) {
+                        auto visitor = this->createVisitor(chunk);
+                        if (visitor.formatArrayValues(pattern, start, start + ParallelDriver::ArrayRangeSize))
+                            return;
+
+                        ParallelDriver::forEachArrayEntry(pattern, start, start + ParallelDriver::ArrayRangeSize, [&](u64, ptrn::Pattern *entry) {
+                            visitor.formatArrayEntry(entry);
+                        });
+                    });
+                }
+
+                driver.addJob([this](OutputSink &chunk) {
+                    auto visitor = this->createVisitor(chunk);
+                    visitor.endArray();
+                });
+            }
+
+            driver.run([&](size_t, std::string_view output) {
+                sink.write(output);
+            });
+        }
+    };
+
+}
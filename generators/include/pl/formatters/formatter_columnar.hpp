@@ -0,0 +1,460 @@
+#include <pl/formatters/formatter.hpp>
+
+#include <pl/helpers/utils.hpp>
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+namespace pl::gen::fmt {
+
+    /*
+     * Array of structs whose members are all plain values, exported as a table with one column per member.
+     * The column offsets are taken from a single entry and the rows are then decoded straight from the data
+     * in bulk without visiting any patterns. All entries of a static array share the layout of its template,
+     * entries of dynamic arrays are checked once to lie back to back and to have the same value layout as the first one.
+     * Nested structs and static arrays of values are flattened into columns named "outer.inner" and "values[0]".
+     */
+    class ColumnarTable {
+    public:
+        enum class ColumnType : u8 {
+            Unsigned    = 0,
+            Signed      = 1,
+            Float       = 2,
+            Boolean     = 3,
+            Character   = 4
+        };
+
+        struct Column {
+            std::string name;
+            ColumnType type;
+            u8 size;
+            u64 offset;             // Relative to the start of the row
+            std::endian endian;
+            std::vector<u8> data;   // Decoded values of the current row group, little endian
+        };
+
+        // Finds all arrays of structs that can be exported as tables in the order they appear in the pattern tree
+        [[nodiscard]] static std::vector<ColumnarTable> find(const PatternLanguage &runtime) {
+            std::vector<ColumnarTable> result;
+
+            for (const auto &pattern : runtime.getPatterns())
+                findTables(pattern.get(), pattern->getVariableName(), result);
+
+            return result;
+        }
+
+        [[nodiscard]] const std::string &getName() const {
+            return this->m_name;
+        }
+
+        [[nodiscard]] u64 getRowCount() const {
+            return this->m_rowCount;
+        }
+
+        [[nodiscard]] const std::vector<Column> &getColumns() const {
+            return this->m_columns;
+        }
+
+        // Decodes the rows in groups of a bounded size. Once the callback is called, the data of all columns holds the values of that group
+        void forEachRowGroup(const std::function<void(u64 firstRow, u64 rowCount)> &callback) {
+            const u64 rowSize = this->m_rowSize;
+            const u64 rowsPerGroup = std::clamp<u64>(MaxGroupSize / rowSize, 1, MaxGroupRows);
+
+            std::vector<u8> rows;
+            for (u64 firstRow = 0; firstRow < this->getRowCount(); firstRow += rowsPerGroup) {
+                const auto rowCount = std::min(rowsPerGroup, this->getRowCount() - firstRow);
+
+                rows.resize(rowCount * rowSize);
+                this->m_evaluator->readData(this->m_offset + firstRow * rowSize, rows.data(), rows.size(), this->m_section);
+
+                for (auto &column : this->m_columns) {
+                    column.data.resize(rowCount * column.size);
+
+                    for (u64 row = 0; row < rowCount; row++)
+                        std::memcpy(column.data.data() + row * column.size, rows.data() + row * rowSize + column.offset, column.size);
+
+                    if (column.endian != std::endian::little)
+                        swapByteOrder(column);
+                }
+
+                callback(firstRow, rowCount);
+            }
+        }
+
+        // Value of a column in the current row group, zero extended to 64 bits
+        [[nodiscard]] static u64 getValue(const Column &column, u64 row) {
+            u64 value = 0;
+            std::memcpy(&value, column.data.data() + row * column.size, column.size);
+
+            return hlp::changeEndianess(value, column.size, std::endian::little);
+        }
+
+    private:
+        ColumnarTable(std::string name, ptrn::Pattern *array, ptrn::Pattern *row)
+            : m_name(std::move(name)), m_evaluator(array->getEvaluator()), m_offset(array->getOffset()), m_rowSize(row->getSize()),
+              m_rowCount(dynamic_cast<ptrn::IIterable *>(array)->getEntryCount()), m_section(row->getSection()) { }
+
+        constexpr static u64 MaxGroupSize = 1024 * 1024;
+        constexpr static u64 MaxGroupRows = 0x10000;
+        constexpr static size_t MaxColumns = 1024;
+
+        // Values are swapped in chunks of their native type so the whole column is converted at once
+        template<std::unsigned_integral T>
+        static void swapByteOrder(std::vector<u8> &data) {
+            std::array<T, 256> chunk;
+
+            for (size_t start = 0; start < data.size(); start += sizeof(chunk)) {
+                const auto size = std::min(sizeof(chunk), data.size() - start);
+                std::memcpy(chunk.data(), data.data() + start, size);
+                hlp::swapByteOrder(chunk.data(), size / sizeof(T));
+                std::memcpy(data.data() + start, chunk.data(), size);
+            }
+        }
+
+        static void swapByteOrder(Column &column) {
+            switch (column.size) {
+                case 1: break;
+                case 2: swapByteOrder<u16>(column.data); break;
+                case 4: swapByteOrder<u32>(column.data); break;
+                case 8: swapByteOrder<u64>(column.data); break;
+                default:
+                    for (size_t offset = 0; offset < column.data.size(); offset += column.size)
+                        std::reverse(column.data.begin() + offset, column.data.begin() + offset + column.size);
+                    break;
+            }
+        }
+
+        [[nodiscard]] static bool isRecord(const ptrn::Pattern *pattern) {
+            if (pattern == nullptr || pattern->getSize() == 0 || pattern->isSealed())
+                return false;
+
+            return dynamic_cast<const ptrn::PatternStruct *>(pattern) != nullptr || dynamic_cast<const ptrn::PatternUnion *>(pattern) != nullptr;
+        }
+
+        static void findTables(ptrn::Pattern *pattern, const std::string &path, std::vector<ColumnarTable> &result) {
+            if (auto array = dynamic_cast<ptrn::PatternArrayStatic *>(pattern); array != nullptr) {
+                const auto &rowTemplate = array->getTemplate();
+                if (!isRecord(rowTemplate.get()))
+                    return;
+
+                // The template may have been moved to any entry, offsets are made relative to its current position
+                ColumnarTable table(path, array, rowTemplate.get());
+                if (table.addColumns(rowTemplate.get(), "", -rowTemplate->getOffset()) && !table.m_columns.empty())
+                    result.push_back(std::move(table));
+            } else if (auto dynamicArray = dynamic_cast<ptrn::PatternArrayDynamic *>(pattern); dynamicArray != nullptr) {
+                if (dynamicArray->getEntryCount() == 0 || !isRecord(dynamicArray->getEntry(0).get()))
+                    return;
+
+                const auto firstRow = dynamicArray->getEntry(0);
+                ColumnarTable table(path, dynamicArray, firstRow.get());
+                if (table.m_offset != firstRow->getOffset() || !table.addColumns(firstRow.get(), "", -table.m_offset) || table.m_columns.empty())
+                    return;
+
+                bool uniform = true;
+                dynamicArray->forEachEntry(1, dynamicArray->getEntryCount(), [&](u64 index, ptrn::Pattern *row) {
+                    if (!uniform)
+                        return;
+
+                    const auto rowOffset = table.m_offset + index * table.m_rowSize;
+                    if (row->getOffset() != rowOffset || row->getSize() != table.m_rowSize || !isRecord(row)) {
+                        uniform = false;
+                        return;
+                    }
+
+                    size_t column = 0;
+                    uniform = table.matchesColumns(row, -rowOffset, column) && column == table.m_columns.size();
+                });
+
+                if (uniform)
+                    result.push_back(std::move(table));
+            } else if (dynamic_cast<ptrn::PatternStruct *>(pattern) != nullptr || dynamic_cast<ptrn::PatternUnion *>(pattern) != nullptr) {
+                dynamic_cast<ptrn::IIterable *>(pattern)->forEachEntry(0, dynamic_cast<ptrn::IIterable *>(pattern)->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                    findTables(member, path + "." + member->getVariableName(), result);
+                });
+            }
+        }
+
+        // Adds a column for every value in the pattern. Returns false if the pattern contains anything that can't be decoded in bulk
+        bool addColumns(ptrn::Pattern *pattern, const std::string &name, u64 shift) {
+            if (pattern->isSealed() || pattern->getSection() != this->m_section)
+                return false;
+            if (!pattern->getTransformFunction().empty() || !pattern->getReadFormatterFunction().empty())
+                return false;
+
+            const auto offset = pattern->getOffset() + shift;
+
+            if (dynamic_cast<ptrn::PatternPadding *>(pattern) != nullptr)
+                return true;
+
+            if (dynamic_cast<ptrn::PatternStruct *>(pattern) != nullptr || dynamic_cast<ptrn::PatternUnion *>(pattern) != nullptr) {
+                bool result = true;
+                dynamic_cast<ptrn::IIterable *>(pattern)->forEachEntry(0, dynamic_cast<ptrn::IIterable *>(pattern)->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                    const auto memberName = name.empty() ? member->getVariableName() : name + "." + member->getVariableName();
+                    result = result && this->addColumns(member, memberName, shift);
+                });
+
+                return result;
+            }
+
+            if (auto array = dynamic_cast<ptrn::PatternArrayStatic *>(pattern); array != nullptr) {
+                const auto &entryTemplate = array->getTemplate();
+                if (entryTemplate == nullptr)
+                    return true;
+                if (this->m_columns.size() + array->getEntryCount() > MaxColumns)
+                    return false;
+
+                for (u64 i = 0; i < array->getEntryCount(); i++) {
+                    const auto entryShift = offset + i * entryTemplate->getSize() - entryTemplate->getOffset();
+                    if (!this->addColumns(entryTemplate.get(), ::fmt::format("{}[{}]", name, i), entryShift))
+                        return false;
+                }
+
+                return true;
+            }
+
+            const auto type = getColumnType(pattern);
+            if (!type.has_value())
+                return false;
+
+            const auto size = pattern->getSize();
+            if (size == 0 || size > sizeof(u64) || (*type == ColumnType::Float && size != 4 && size != 8))
+                return false;
+            if (offset + size > this->m_rowSize || this->m_columns.size() >= MaxColumns)
+                return false;
+
+            this->m_columns.push_back({ name, *type, u8(size), offset, pattern->getEndian(), { } });
+
+            return true;
+        }
+
+        // Checks that the values of a pattern line up with the existing columns, starting at the given column.
+        // Used for the entries of dynamic arrays so they're compared to the first entry without building any columns or names
+        [[nodiscard]] bool matchesColumns(ptrn::Pattern *pattern, u64 shift, size_t &column) const {
+            if (pattern->isSealed() || pattern->getSection() != this->m_section)
+                return false;
+            if (!pattern->getTransformFunction().empty() || !pattern->getReadFormatterFunction().empty())
+                return false;
+
+            const auto offset = pattern->getOffset() + shift;
+
+            if (dynamic_cast<ptrn::PatternPadding *>(pattern) != nullptr)
+                return true;
+
+            if (dynamic_cast<ptrn::PatternStruct *>(pattern) != nullptr || dynamic_cast<ptrn::PatternUnion *>(pattern) != nullptr) {
+                bool result = true;
+                dynamic_cast<ptrn::IIterable *>(pattern)->forEachEntry(0, dynamic_cast<ptrn::IIterable *>(pattern)->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                    result = result && this->matchesColumns(member, shift, column);
+                });
+
+                return result;
+            }
+
+            if (auto array = dynamic_cast<ptrn::PatternArrayStatic *>(pattern); array != nullptr) {
+                const auto &entryTemplate = array->getTemplate();
+                if (entryTemplate == nullptr)
+                    return true;
+
+                for (u64 i = 0; i < array->getEntryCount(); i++) {
+                    const auto entryShift = offset + i * entryTemplate->getSize() - entryTemplate->getOffset();
+                    if (!this->matchesColumns(entryTemplate.get(), entryShift, column))
+                        return false;
+                }
+
+                return true;
+            }
+
+            if (column >= this->m_columns.size())
+                return false;
+
+            const auto &expected = this->m_columns[column++];
+            return getColumnType(pattern) == expected.type && pattern->getSize() == expected.size && offset == expected.offset && pattern->getEndian() == expected.endian;
+        }
+
+        [[nodiscard]] static std::optional<ColumnType> getColumnType(const ptrn::Pattern *pattern) {
+            if (dynamic_cast<const ptrn::PatternUnsigned *>(pattern) != nullptr || dynamic_cast<const ptrn::PatternEnum *>(pattern) != nullptr)
+                return ColumnType::Unsigned;
+            else if (dynamic_cast<const ptrn::PatternSigned *>(pattern) != nullptr)
+                return ColumnType::Signed;
+            else if (dynamic_cast<const ptrn::PatternFloat *>(pattern) != nullptr)
+                return ColumnType::Float;
+            else if (dynamic_cast<const ptrn::PatternBoolean *>(pattern) != nullptr)
+                return ColumnType::Boolean;
+            else if (dynamic_cast<const ptrn::PatternCharacter *>(pattern) != nullptr)
+                return ColumnType::Character;
+            else
+                return std::nullopt;
+        }
+
+    private:
+        std::string m_name;
+        core::Evaluator *m_evaluator;
+        u64 m_offset, m_rowSize, m_rowCount, m_section;
+        std::vector<Column> m_columns;
+    };
+
+    // Every table is written as a header row followed by its rows. If there are multiple tables, each of them
+    // is preceded by a line holding its name and separated from the previous one by an empty line
+    class FormatterCsv : public StreamingFormatter {
+    public:
+        FormatterCsv() : StreamingFormatter("csv") { }
+        ~FormatterCsv() override = default;
+
+        [[nodiscard]] std::string getFileExtension() const override { return "csv"; }
+
+        [[nodiscard]] bool canFormat(const PatternLanguage &runtime) const override {
+            return !ColumnarTable::find(runtime).empty();
+        }
+
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override {
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            auto tables = ColumnarTable::find(runtime);
+            for (auto &table : tables) {
+                if (tables.size() > 1) {
+                    if (&table != &tables.front())
+                        sink.write('\n');
+
+                    writeField(sink, table.getName());
+                    sink.write('\n');
+                }
+
+                const auto &columns = table.getColumns();
+                for (const auto &column : columns) {
+                    if (&column != &columns.front())
+                        sink.write(',');
+                    writeField(sink, column.name);
+                }
+                sink.write('\n');
+
+                table.forEachRowGroup([&](u64, u64 rowCount) {
+                    for (u64 row = 0; row < rowCount; row++) {
+                        for (const auto &column : columns) {
+                            if (&column != &columns.front())
+                                sink.write(',');
+                            writeCell(sink, column, row);
+                        }
+                        sink.write('\n');
+                    }
+                });
+            }
+
+            sink.flush();
+        }
+
+    private:
+        static void writeField(OutputSink &sink, std::string_view field) {
+            if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+                sink.write(field);
+                return;
+            }
+
+            sink.write('"');
+            for (char c : field) {
+                if (c == '"')
+                    sink.write('"');
+                sink.write(c);
+            }
+            sink.write('"');
+        }
+
+        static void writeCell(OutputSink &sink, const ColumnarTable::Column &column, u64 row) {
+            const auto value = ColumnarTable::getValue(column, row);
+
+            ::fmt::memory_buffer buffer;
+            switch (column.type) {
+                using enum ColumnarTable::ColumnType;
+                case Unsigned:
+                    ::fmt::format_to(std::back_inserter(buffer), "{}", value);
+                    break;
+                case Signed:
+                    ::fmt::format_to(std::back_inserter(buffer), "{}", hlp::signExtend(column.size * 8, value));
+                    break;
+                case Float:
+                    if (column.size == 4)
+                        ::fmt::format_to(std::back_inserter(buffer), "{}", std::bit_cast<float>(u32(value)));
+                    else
+                        ::fmt::format_to(std::back_inserter(buffer), "{}", std::bit_cast<double>(value));
+                    break;
+                case Boolean:
+                    sink.write(value != 0 ? "true" : "false");
+                    return;
+                case Character: {
+                    const char character = char(value);
+                    writeField(sink, std::string_view(&character, 1));
+                    return;
+                }
+            }
+
+            sink.write(std::string_view(buffer.data(), buffer.size()));
+        }
+    };
+
+    /*
+     * Compact binary version of the tables, all values little endian:
+     *   "PLCOLUMN", u32 version, u32 table count
+     *   For every table:  u32 name length, name, u64 row count, u32 column count
+     *   For every column: u32 name length, name, u8 type (ColumnarTable::ColumnType), u8 value size
+     * Followed by the data of each table in the same order, split into row groups of
+     *   u64 row count, then for every column the values of those rows back to back
+     */
+    class FormatterColumnar : public StreamingFormatter {
+    public:
+        FormatterColumnar() : StreamingFormatter("columnar") { }
+        ~FormatterColumnar() override = default;
+
+        [[nodiscard]] std::string getFileExtension() const override { return "plcol"; }
+
+        [[nodiscard]] bool canFormat(const PatternLanguage &runtime) const override {
+            return !ColumnarTable::find(runtime).empty();
+        }
+
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override {
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            auto tables = ColumnarTable::find(runtime);
+
+            sink.write("PLCOLUMN");
+            writeInteger(sink, Version, sizeof(u32));
+            writeInteger(sink, tables.size(), sizeof(u32));
+
+            for (const auto &table : tables) {
+                writeString(sink, table.getName());
+                writeInteger(sink, table.getRowCount(), sizeof(u64));
+                writeInteger(sink, table.getColumns().size(), sizeof(u32));
+
+                for (const auto &column : table.getColumns()) {
+                    writeString(sink, column.name);
+                    writeInteger(sink, u8(column.type), sizeof(u8));
+                    writeInteger(sink, column.size, sizeof(u8));
+                }
+            }
+
+            for (auto &table : tables) {
+                table.forEachRowGroup([&](u64, u64 rowCount) {
+                    writeInteger(sink, rowCount, sizeof(u64));
+
+                    for (const auto &column : table.getColumns())
+                        sink.write(column.data.data(), column.data.size());
+                });
+            }
+
+            sink.flush();
+        }
+
+    private:
+        constexpr static u32 Version = 1;
+
+        static void writeInteger(OutputSink &sink, u64 value, size_t size) {
+            value = hlp::changeEndianess(value, size, std::endian::little);
+            sink.write(reinterpret_cast<const u8 *>(&value), size);
+        }
+
+        static void writeString(OutputSink &sink, std::string_view string) {
+            writeInteger(sink, string.size(), sizeof(u32));
+            sink.write(string);
+        }
+    };
+
+}
@@ -1,77 +1,237 @@
 #include <pl/formatters/formatter.hpp>
+#include <pl/formatters/parallel_driver.hpp>
+#include <pl/helpers/static_interval_index.hpp>
+
+#include <limits>
 
 namespace pl::gen::fmt {
 
-    class FormatterHtml : public Formatter {
+    /*
+     * Hex view of the data with the bytes of every pattern highlighted in its color.
+     * The output is generated in a single sweep over the pattern intervals overlapping the data, sorted by their start address.
+     * Consecutive bytes covered by the same patterns form one group that shows a single tooltip for all of them.
+     * The data is split into pages that can be expanded individually and only the first bytes up to the size limit
+     * are included so large inputs still produce output a browser can handle.
+     */
+    class FormatterHtml : public StreamingFormatter {
     public:
-        FormatterHtml() : Formatter("html") { }
+        FormatterHtml() : StreamingFormatter("html") { }
         ~FormatterHtml() override = default;
 
         [[nodiscard]] std::string getFileExtension() const override { return "html"; }
 
-        [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) override {
-            auto result = generateHtml(runtime);
-
-            return { result.begin(), result.end() };
+        // Number of bytes per page, rounded up to full rows
+        void setPageSize(u64 pageSize) {
+            this->m_pageSize = std::max<u64>((pageSize + RowSize - 1) & ~(RowSize - 1), RowSize);
         }
 
-    private:
-        static std::string generateTooltip(const std::vector<ptrn::Pattern*> &patterns) {
-            if (patterns.empty())
-                return "";
+        // Maximum number of bytes included in the output. 0 includes all data
+        void setMaxSize(u64 maxSize) {
+            this->m_maxSize = maxSize;
+        }
 
-            std::string content;
-            for (auto *pattern : patterns) {
-                content += ::fmt::format(R"html({} {} | {}<br>)html", pattern->getFormattedName(), pattern->getVariableName(), pattern->toString());
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override {
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            auto &evaluator = *runtime.getInternals().evaluator;
+            const auto baseAddress = evaluator.getDataBaseAddress();
+            const auto dataSize = evaluator.getDataSize();
+            const auto size = this->m_maxSize == 0 ? dataSize : std::min(dataSize, this->m_maxSize);
+
+            const auto intervals = collectIntervals(runtime, baseAddress, size);
+
+            sink.write(HtmlPrefix);
+            writeHeaderRow(sink);
+
+            auto formatPage = [&](OutputSink &pageSink, u64 pageStart) {
+                const auto pageEnd = std::min(pageStart + this->m_pageSize, size);
+                this->generatePage(pageSink, runtime, intervals, baseAddress, baseAddress + pageStart, baseAddress + pageEnd);
+            };
+
+            if (this->getThreadCount() > 1) {
+                ParallelDriver driver(runtime, this->getThreadCount());
+                for (u64 pageStart = 0; pageStart < size; pageStart += this->m_pageSize) {
+                    driver.addJob([&formatPage, pageStart](OutputSink &chunk) {
+                        formatPage(chunk, pageStart);
+                    });
+                }
+
+                driver.run([&](size_t, std::string_view output) {
+                    sink.write(output);
+                });
+            } else {
+                for (u64 pageStart = 0; pageStart < size; pageStart += this->m_pageSize)
+                    formatPage(sink, pageStart);
             }
 
-            if (!content.empty())
-                content.resize(content.size() - 4);
+            if (size < dataSize)
+                sink.write(::fmt::format(R"html(<div class="pattern_language_truncated">Showing the first {} of {} bytes</div>)html", size, dataSize));
 
-            return ::fmt::format(R"html(<br><span class="pattern_language_tooltip" style="background-color: #{:08X}"><div class="pattern_language_tooltip_text">{}</div></span>)html", (hlp::changeEndianess(patterns.front()->getColor(), std::endian::big) | 0x000000FF) & 0xAFAFAFFF, content);
+            sink.write(HtmlSuffix);
+            sink.flush();
         }
 
-        static std::string generateCell(u64 address, const PatternLanguage &runtime) {
-            auto patterns = runtime.getPatternsAtAddress(address);
-
-            u8 byte = 0;
-            runtime.getInternals().evaluator->readData(address, &byte, sizeof(byte), ptrn::Pattern::MainSectionId);
+    private:
+        constexpr static u64 RowSize = 0x10;
+        constexpr static std::string_view HexDigits = "0123456789ABCDEF";
+
+        struct Interval {
+            u64 start, end;
+            u64 address;
+            ptrn::Pattern *pattern;
+        };
+
+        struct Intervals {
+            std::vector<Interval> sorted;
+            hlp::StaticIntervalIndex<size_t> index;     // Indices into sorted, used to find the patterns reaching into a page
+        };
+
+        struct ActivePattern {
+            u64 end;
+            ptrn::Pattern *pattern;
+            std::string description;
+        };
+
+        static Intervals collectIntervals(const PatternLanguage &runtime, u64 baseAddress, u64 size) {
+            Intervals result;
+            if (size == 0)
+                return result;
+
+            for (const auto &range : runtime.getPatternsInRange(baseAddress, baseAddress + size - 1))
+                result.sorted.push_back({ range.start, range.end + 1, range.address, range.pattern });
+
+            std::vector<hlp::StaticIntervalIndex<size_t>::Element> elements;
+            elements.reserve(result.sorted.size());
+            for (size_t i = 0; i < result.sorted.size(); i++)
+                elements.push_back({ { result.sorted[i].start, result.sorted[i].end - 1 }, i });
+            result.index = hlp::StaticIntervalIndex<size_t>(std::move(elements));
 
-            return ::fmt::format(R"html(<div class="pattern_language_cell" style="background-color: #{}">{:02X}{}</div>)html",
-                                 patterns.empty() ? "transparent" : ::fmt::format("{:08X}", hlp::changeEndianess(patterns.front()->getColor(), std::endian::big)),
-                                 byte,
-                                 generateTooltip(patterns)
-                                 );
+            return result;
         }
 
-        static std::string generateRow(u64 address, const PatternLanguage &runtime) {
+        static std::string escapeHtml(std::string_view string) {
             std::string result;
+            result.reserve(string.size());
+
+            for (char c : string) {
+                switch (c) {
+                    case '&': result += "&amp;";    break;
+                    case '<': result += "&lt;";     break;
+                    case '>': result += "&gt;";     break;
+                    case '"': result += "&quot;";   break;
+                    default:  result += c;          break;
+                }
+            }
 
-            result += R"html(<div class="pattern_language_row">)html";
-            result += ::fmt::format(R"html(<div class="pattern_language_address">{:08X}</div>)html", address);
+            return result;
+        }
 
-            for (u64 i = address; i < runtime.getInternals().evaluator->getDataSize() && i < address + 0x10; i++) {
-                result += generateCell(i, runtime);
+        static ActivePattern activatePattern(const PatternLanguage &runtime, const Interval &interval) {
+            // Patterns in arrays are shared by all entries and need to be moved to the entry first
+            auto lock = runtime.getInternals().evaluator->lockSharedState();
 
-                if ((i & 0x0F) == 0x07)
-                    result += R"html(<div class="pattern_language_cell">&nbsp;</div>)html";
-            }
+            interval.pattern->setOffset(interval.address);
+            interval.pattern->clearFormatCache();
 
-            result += R"html(</div><br>)html";
+            auto description = ::fmt::format("{} {} | {}", interval.pattern->getFormattedName(), interval.pattern->getVariableName(), interval.pattern->toString());
 
-            return result;
+            return { interval.end, interval.pattern, escapeHtml(description) };
         }
 
-        static std::string generateHtml(const PatternLanguage &runtime) {
-            std::string rows;
+        static u32 getHtmlColor(const ptrn::Pattern *pattern) {
+            return hlp::changeEndianess(pattern->getColor(), std::endian::big);
+        }
 
-            auto &evaluator = runtime.getInternals().evaluator;
+        static void writeTooltip(OutputSink &sink, const std::vector<ActivePattern> &patterns) {
+            sink.write(::fmt::format(R"html(<span class="pattern_language_tooltip" style="background-color: #{:08X}"><span class="pattern_language_tooltip_text">)html",
+                                     (getHtmlColor(patterns.front().pattern) | 0x000000FF) & 0xAFAFAFFF));
 
-            for (u64 i = evaluator->getDataBaseAddress(); i < evaluator->getDataSize(); i += 0x10) {
-                rows += generateRow(i, runtime);
+            for (const auto &active : patterns) {
+                if (&active != &patterns.front())
+                    sink.write("<br>");
+                sink.write(active.description);
             }
 
-            return R"html(
+            sink.write("</span></span>");
+        }
+
+        void generatePage(OutputSink &sink, const PatternLanguage &runtime, const Intervals &intervals, u64 baseAddress, u64 start, u64 end) const {
+            std::vector<u8> data(end - start);
+            runtime.getInternals().evaluator->readData(start, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            // Patterns that started before this page and reach into it
+            std::vector<ActivePattern> active;
+            intervals.index.forEachOverlapping({ start, start }, [&](const auto &interval, size_t index) {
+                if (interval.start < start)
+                    active.push_back(activatePattern(runtime, intervals.sorted[index]));
+            });
+
+            auto next = size_t(std::partition_point(intervals.sorted.begin(), intervals.sorted.end(), [start](const Interval &interval) { return interval.start < start; }) - intervals.sorted.begin());
+
+            sink.write(::fmt::format(R"html(<details class="pattern_language_page"{}><summary>{:08X} - {:08X}</summary>)html", start == baseAddress ? " open" : "", start, end - 1));
+
+            bool groupOpen = false;
+            std::string cellStart;
+            u64 nextChange = 0;
+            for (u64 address = start; address < end; address++) {
+                const auto column = (address - baseAddress) % RowSize;
+                if (column == 0)
+                    sink.write(::fmt::format(R"html(<span class="pattern_language_address">{:08X}</span>)html", address));
+
+                // Start a new group whenever a pattern starts or ends
+                if (address >= nextChange) {
+                    std::erase_if(active, [address](const ActivePattern &pattern) { return pattern.end <= address; });
+                    for (; next < intervals.sorted.size() && intervals.sorted[next].start <= address; next++)
+                        active.push_back(activatePattern(runtime, intervals.sorted[next]));
+
+                    if (groupOpen)
+                        sink.write("</span>");
+
+                    groupOpen = !active.empty();
+                    if (groupOpen) {
+                        sink.write(R"html(<span class="pattern_language_pattern">)html");
+                        writeTooltip(sink, active);
+                        cellStart = ::fmt::format(R"html(<span class="pattern_language_cell" style="background-color: #{:08X}">)html", getHtmlColor(active.front().pattern));
+                    } else {
+                        cellStart = R"html(<span class="pattern_language_cell">)html";
+                    }
+
+                    nextChange = next < intervals.sorted.size() ? intervals.sorted[next].start : std::numeric_limits<u64>::max();
+                    for (const auto &pattern : active)
+                        nextChange = std::min(nextChange, pattern.end);
+                }
+
+                sink.write(cellStart);
+                sink.write(HexDigits[data[address - start] >> 4]);
+                sink.write(HexDigits[data[address - start] & 0x0F]);
+                sink.write("</span>");
+
+                if (column == 0x07 && address + 1 != end)
+                    sink.write(R"html(<span class="pattern_language_cell">&nbsp;</span>)html");
+                if (column == RowSize - 1 || address + 1 == end)
+                    sink.write("<br>");
+            }
+
+            if (groupOpen)
+                sink.write("</span>");
+
+            sink.write("</details>");
+        }
+
+        static void writeHeaderRow(OutputSink &sink) {
+            sink.write(R"html(<div class="pattern_language_row"><span class="pattern_language_address">&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;</span>)html");
+            for (u64 column = 0; column < RowSize; column++) {
+                sink.write(::fmt::format(R"html(<span class="pattern_language_cell">{:02X}</span>)html", column));
+                if (column == 0x07)
+                    sink.write(R"html(<span class="pattern_language_cell">&nbsp;</span>)html");
+            }
+            sink.write("</div>");
+        }
+
+        u64 m_pageSize = 0x10000;
+        u64 m_maxSize = 0x1000000;
+
+        constexpr static auto HtmlPrefix = R"html(
 <div>
     <style type="text/css">
         .pattern_language_container {
@@ -83,19 +243,20 @@ namespace pl::gen::fmt {
         }
 
         .pattern_language_address {
-            float: left;
+            display: inline-block;
             padding-right: 10px;
             font-family: monospace;
         }
 
         .pattern_language_cell {
-            float: left;
+            display: inline-block;
             padding-left: 1px;
             padding-right: 1px;
             font-family: monospace;
         }
 
         .pattern_language_tooltip_text {
+            display: block;
             color: white;
             text-align: center;
         }
@@ -111,38 +272,23 @@ namespace pl::gen::fmt {
             pointer-events : none
         }
 
-        .pattern_language_cell:hover .pattern_language_tooltip {
+        .pattern_language_pattern:hover .pattern_language_tooltip {
             visibility: visible;
         }
+
+        .pattern_language_page summary {
+            font-family: monospace;
+            cursor: pointer;
+        }
     </style>
 
     <div class="pattern_language_container">
-        <div class="pattern_language_row">
-            <div class="pattern_language_address">&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;</div>
-            <div class="pattern_language_cell">00</div>
-            <div class="pattern_language_cell">01</div>
-            <div class="pattern_language_cell">02</div>
-            <div class="pattern_language_cell">03</div>
-            <div class="pattern_language_cell">04</div>
-            <div class="pattern_language_cell">05</div>
-            <div class="pattern_language_cell">06</div>
-            <div class="pattern_language_cell">07</div>
-            <div class="pattern_language_cell">&nbsp;</div>
-            <div class="pattern_language_cell">08</div>
-            <div class="pattern_language_cell">09</div>
-            <div class="pattern_language_cell">0A</div>
-            <div class="pattern_language_cell">0B</div>
-            <div class="pattern_language_cell">0C</div>
-            <div class="pattern_language_cell">0D</div>
-            <div class="pattern_language_cell">0E</div>
-            <div class="pattern_language_cell">0F</div>
-        </div>
-        <br>
-        )html" + rows + R"html(
+        )html";
+
+        constexpr static auto HtmlSuffix = R"html(
     </div>
 </div>
             )html";
-        }
     };
 
-}
\ No newline at end of file
+}
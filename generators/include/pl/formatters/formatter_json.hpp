@@ -1,10 +1,11 @@
 #include <pl/formatters/formatter.hpp>
+#include <pl/formatters/parallel_driver.hpp>
 
 namespace pl::gen::fmt {
 
     class JsonPatternVisitor : public FormatterPatternVisitor {
     public:
-        JsonPatternVisitor() = default;
+        explicit JsonPatternVisitor(OutputSink &sink) : m_sink(sink) { }
 
         void visit(pl::ptrn::PatternArrayDynamic& pattern)  override { formatArray(&pattern);       }
         void visit(pl::ptrn::PatternArrayStatic& pattern)   override { formatArray(&pattern);       }
@@ -25,10 +26,6 @@ namespace pl::gen::fmt {
         void visit(pl::ptrn::PatternWideCharacter& pattern) override { formatString(&pattern);      }
         void visit(pl::ptrn::PatternWideString& pattern)    override { formatString(&pattern);      }
 
-        [[nodiscard]] auto getResult() const {
-            return this->m_result;
-        }
-
         void pushIndent() {
             this->m_indent += 4;
         }
@@ -36,20 +33,72 @@ namespace pl::gen::fmt {
         void popIndent() {
             this->m_indent -= 4;
 
-            if (this->m_result.size() >= 2 && this->m_result.substr(this->m_result.size() - 2) == ",\n") {
-                this->m_result.pop_back();
-                this->m_result.pop_back();
-                this->m_result.push_back('\n');
+            // The last entry of an object or array must not be followed by a comma
+            if (this->m_lineEnd == LineEnd::Comma)
+                this->m_lineEnd = LineEnd::NewLine;
+        }
+
+        void beginArray(pl::ptrn::Pattern *pattern) {
+            addLine(pattern->getVariableName(), "[", false);
+            pushIndent();
+        }
+
+        void formatArrayEntry(pl::ptrn::Pattern *entry) {
+            this->m_inArray = true;
+            entry->accept(*this);
+        }
+
+        // Formats the entries [start, end) of arrays of plain numbers straight from their decoded values.
+        // Returns false if the entries need to be visited instead
+        bool formatArrayValues(pl::ptrn::Pattern *pattern, u64 start, u64 end) {
+            const auto encoding = getBulkEncoding(pattern);
+            if (!encoding.has_value())
+                return false;
+
+            switch (encoding->type) {
+                using enum hlp::ValueEncoding::Type;
+                case Unsigned:  formatNumbers<u64>(pattern, start, end);    return true;
+                case Signed:    formatNumbers<i64>(pattern, start, end);    return true;
+                case Float:     formatNumbers<double>(pattern, start, end); return true;
+                default:        return false;
             }
         }
 
+        void endArray() {
+            popIndent();
+            addLine("", "]", true, true);
+        }
+
+        // Terminates the line that was written last
+        void endLine() {
+            switch (this->m_lineEnd) {
+                case LineEnd::None:
+                    break;
+                case LineEnd::NewLine:
+                    this->m_sink.write('\n');
+                    break;
+                case LineEnd::Comma:
+                    this->m_sink.write(",\n");
+                    break;
+            }
+
+            this->m_lineEnd = LineEnd::None;
+        }
+
     private:
-        void addLine(const std::string &variableName, const std::string& str, bool noVariableName = false) {
-            this->m_result += std::string(this->m_indent, ' ');
-            if (!noVariableName && !this->m_inArray)
-                this->m_result += ::fmt::format("\"{}\": ", variableName);
+        // Lines are written without their ending as whether they need a comma is only known once the next line is added
+        void addLine(const std::string &variableName, std::string_view str, bool comma, bool noVariableName = false) {
+            this->endLine();
 
-            this->m_result  += str + "\n";
+            this->m_sink.write(this->m_indent, ' ');
+            if (!noVariableName && !this->m_inArray) {
+                this->m_sink.write('"');
+                this->m_sink.write(variableName);
+                this->m_sink.write("\": ");
+            }
+
+            this->m_sink.write(str);
+            this->m_lineEnd = comma ? LineEnd::Comma : LineEnd::NewLine;
 
             this->m_inArray = false;
         }
@@ -59,27 +108,37 @@ namespace pl::gen::fmt {
             result = wolv::util::replaceStrings(result, "\n", " ");
             result = hlp::encodeByteString({ result.begin(), result.end() });
 
-            addLine(pattern->getVariableName(), ::fmt::format("\"{}\",", result));
+            addLine(pattern->getVariableName(), ::fmt::format("\"{}\"", result), true);
         }
 
         template<typename T>
         void formatArray(T *pattern) {
-            addLine(pattern->getVariableName(), "[");
-            pushIndent();
-            pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
-                this->m_inArray = true;
-                member->accept(*this);
+            beginArray(pattern);
+            if (!formatArrayValues(pattern, 0, pattern->getEntryCount())) {
+                pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                    formatArrayEntry(member);
+                });
+            }
+            endArray();
+        }
+
+        // Written the same way formatValue() writes the value of a single entry
+        template<typename T>
+        void formatNumbers(pl::ptrn::Pattern *pattern, u64 start, u64 end) {
+            forEachValueChunk<T>(pattern, start, end, [&](std::span<const T> values) {
+                for (const auto value : values) {
+                    this->m_inArray = true;
+                    addLine("", ::fmt::format("\"{}\"", value), true);
+                }
             });
-            popIndent();
-            addLine("", "],", true);
         }
 
         void formatPointer(ptrn::PatternPointer *pattern) {
-            addLine(pattern->getVariableName(), "{");
+            addLine(pattern->getVariableName(), "{", false);
             pushIndent();
             pattern->getPointedAtPattern()->accept(*this);
             popIndent();
-            addLine("", "},", true);
+            addLine("", "}", true, true);
         }
 
         template<typename T>
@@ -87,17 +146,17 @@ namespace pl::gen::fmt {
             if (pattern->isSealed()) {
                 formatValue(pattern);
             } else {
-                addLine(pattern->getVariableName(), "{");
+                addLine(pattern->getVariableName(), "{", false);
                 pushIndent();
 
                 for (const auto &[name, value] : this->getMetaInformation(pattern))
-                    addLine(name, ::fmt::format("\"{}\",", value));
+                    addLine(name, ::fmt::format("\"{}\"", value), true);
 
                 pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
                     member->accept(*this);
                 });
                 popIndent();
-                addLine("", "},", true);
+                addLine("", "}", true, true);
             }
         }
 
@@ -105,36 +164,132 @@ namespace pl::gen::fmt {
             if (auto functionName = pattern->getReadFormatterFunction(); !functionName.empty())
                 formatString(pattern);
             else if (!pattern->isSealed())
-                addLine(pattern->getVariableName(), ::fmt::format("\"{}\",", pattern->toString()));
+                addLine(pattern->getVariableName(), ::fmt::format("\"{}\"", pattern->toString()), true);
         }
 
     private:
+        enum class LineEnd {
+            None,
+            NewLine,
+            Comma
+        };
+
+        OutputSink &m_sink;
         bool m_inArray = false;
-        std::string m_result;
+        LineEnd m_lineEnd = LineEnd::None;
         u32 m_indent = 0;
     };
 
-    class FormatterJson : public Formatter {
+    class FormatterJson : public StreamingFormatter {
     public:
-        FormatterJson() : Formatter("json") { }
+        FormatterJson() : StreamingFormatter("json") { }
         ~FormatterJson() override = default;
 
         [[nodiscard]] std::string getFileExtension() const override { return "json"; }
 
-        [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) override {
-            JsonPatternVisitor visitor;
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override {
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            sink.write("{\n");
+
+            if (this->getThreadCount() > 1) {
+                formatParallel(runtime, sink);
+            } else {
+                auto visitor = this->createVisitor(sink);
+
+                visitor.pushIndent();
+                for (const auto& pattern : runtime.getPatterns()) {
+                    pattern->accept(visitor);
+                }
+                visitor.popIndent();
+                visitor.endLine();
+            }
+
+            sink.write('}');
+            sink.flush();
+        }
+
+    private:
+        enum class ChunkKind {
+            Entries,
+            ArrayBegin,
+            ArrayEnd
+        };
+
+        [[nodiscard]] JsonPatternVisitor createVisitor(OutputSink &sink, u32 indentLevel = 0) const {
+            JsonPatternVisitor visitor(sink);
             visitor.enableMetaInformation(this->isMetaInformationEnabled());
 
-            visitor.pushIndent();
-            for (const auto& pattern : runtime.getPatterns()) {
-                pattern->accept(visitor);
+            for (u32 i = 0; i < indentLevel; i++)
+                visitor.pushIndent();
+
+            return visitor;
+        }
+
+        // Chunks are formatted without the ending of their last line. It's only added once the
+        // next non-empty chunk is known, the same way the visitor handles its own lines
+        void formatParallel(const PatternLanguage &runtime, OutputSink &sink) {
+            ParallelDriver driver(runtime, this->getThreadCount());
+            std::vector<ChunkKind> chunkKinds;
+
+            auto addJob = [&](ChunkKind kind, ParallelDriver::Job job) {
+                driver.addJob(std::move(job));
+                chunkKinds.push_back(kind);
+            };
+
+            for (const auto &pattern : runtime.getPatterns()) {
+                auto array = ParallelDriver::getSplittableArray(pattern.get());
+                if (array == nullptr) {
+                    addJob(ChunkKind::Entries, [this, pattern = pattern.get()](OutputSink &chunk) {
+                        auto visitor = this->createVisitor(chunk, 1);
+                        pattern->accept(visitor);
+                    });
+
+                    continue;
+                }
+
+                addJob(ChunkKind::ArrayBegin, [this, pattern = pattern.get()](OutputSink &chunk) {
+                    auto visitor = this->createVisitor(chunk, 1);
+                    visitor.beginArray(pattern);
+                });
+
+                for (u64 start = 0; start < array->getEntryCount(); start += ParallelDriver::ArrayRangeSize) {
+                    addJob(ChunkKind::Entries, [this, pattern = pattern.get(), start](OutputSink &chunk) {
+                        auto visitor = this->createVisitor(chunk, 2);
+                        if (visitor.formatArrayValues(pattern, start, start + ParallelDriver::ArrayRangeSize))
+                            return;
+
+                        ParallelDriver::forEachArrayEntry(pattern, start, start + ParallelDriver::ArrayRangeSize, [&](u64, ptrn::Pattern *entry) {
+                            visitor.formatArrayEntry(entry);
+                        });
+                    });
+                }
+
+                addJob(ChunkKind::ArrayEnd, [this](OutputSink &chunk) {
+                    auto visitor = this->createVisitor(chunk, 2);
+                    visitor.endArray();
+                });
             }
-            visitor.popIndent();
 
-            auto result = visitor.getResult();
-            result = ::fmt::format("{{\n{}}}", result);
+            std::optional<ChunkKind> previousKind;
+            driver.run([&](size_t index, std::string_view output) {
+                if (output.empty())
+                    return;
+
+                const auto kind = chunkKinds[index];
+                if (previousKind.has_value()) {
+                    if (*previousKind != ChunkKind::ArrayBegin && kind != ChunkKind::ArrayEnd)
+                        sink.write(",\n");
+                    else
+                        sink.write('\n');
+                }
+
+                sink.write(output);
+                previousKind = kind;
+            });
 
-            return { result.begin(), result.end() };
+            if (previousKind.has_value())
+                sink.write('\n');
         }
     };
 
@@ -1,4 +1,5 @@
 #include <pl/formatters/formatter.hpp>
+#include <pl/formatters/parallel_driver.hpp>
 
 namespace pl::gen::fmt {
 
@@ -37,6 +38,20 @@ namespace pl::gen::fmt {
             this->m_indent -= indent;
         }
 
+        void beginArray(pl::ptrn::Pattern *pattern) {
+            addLine(pattern->getVariableName());
+            pushIndent();
+        }
+
+        void formatArrayEntry(pl::ptrn::Pattern *entry) {
+            this->m_inArray = true;
+            entry->accept(*this);
+        }
+
+        void endArray() {
+            popIndent();
+        }
+
     private:
         void addLine(const std::string &variableName, const std::string &str = "", bool addDash = false) {
             this->m_result += std::string(this->m_indent, ' ');
@@ -51,13 +66,11 @@ namespace pl::gen::fmt {
 
         template<typename T>
         void formatArray(T *pattern) {
-            addLine(pattern->getVariableName());
-            pushIndent();
+            beginArray(pattern);
             pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
-                this->m_inArray = true;
-                member->accept(*this);
+                formatArrayEntry(member);
             });
-            popIndent();
+            endArray();
         }
 
         void formatPointer(ptrn::PatternPointer *pattern) {
@@ -118,8 +131,9 @@ namespace pl::gen::fmt {
         [[nodiscard]] std::string getFileExtension() const override { return "yml"; }
 
         [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) override {
-            YamlPatternVisitor visitor;
-            visitor.enableMetaInformation(this->isMetaInformationEnabled());
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            auto visitor = this->createVisitor();
 
             for (const auto& pattern : runtime.getPatterns()) {
                 pattern->accept(visitor);
@@ -128,6 +142,60 @@ namespace pl::gen::fmt {
             auto result = "---\n" + visitor.getResult();
             return { result.begin(), result.end() };
         }
+
+        void formatTo(const PatternLanguage &runtime, OutputSink &sink) override {
+            if (this->getThreadCount() <= 1) {
+                Formatter::formatTo(runtime, sink);
+                return;
+            }
+
+            auto span = runtime.getTracer().beginSpan("formatter", this->getName());
+
+            ParallelDriver driver(runtime, this->getThreadCount());
+            for (const auto &pattern : runtime.getPatterns()) {
+                auto array = ParallelDriver::getSplittableArray(pattern.get());
+                if (array == nullptr) {
+                    driver.addJob([this, pattern = pattern.get()](OutputSink &chunk) {
+                        auto visitor = this->createVisitor();
+                        pattern->accept(visitor);
+                        chunk.write(visitor.getResult());
+                    });
+
+                    continue;
+                }
+
+                driver.addJob([this, pattern = pattern.get()](OutputSink &chunk) {
+                    auto visitor = this->createVisitor();
+                    visitor.beginArray(pattern);
+                    chunk.write(visitor.getResult());
+                });
+
+                for (u64 start = 0; start < array->getEntryCount(); start += ParallelDriver::ArrayRangeSize) {
+                    driver.addJob([this, pattern = pattern.get(), start](OutputSink &chunk) {
+                        auto visitor = this->createVisitor();
+                        visitor.pushIndent();
+                        ParallelDriver::forEachArrayEntry(pattern, start, start + ParallelDriver::ArrayRangeSize, [&](u64, ptrn::Pattern *entry) {
+                            visitor.formatArrayEntry(entry);
+                        });
+                        chunk.write(visitor.getResult());
+                    });
+                }
+            }
+
+            sink.write("---\n");
+            driver.run([&](size_t, std::string_view output) {
+                sink.write(output);
+            });
+            sink.flush();
+        }
+
+    private:
+        [[nodiscard]] YamlPatternVisitor createVisitor() const {
+            YamlPatternVisitor visitor;
+            visitor.enableMetaInformation(this->isMetaInformationEnabled());
+
+            return visitor;
+        }
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <pl/formatters/formatter.hpp>
+
+#include <wolv/utils/guards.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace pl::gen::fmt {
+
+    /*
+     * Formats independent parts of the output, e.g. top-level patterns or ranges of a large array, on worker threads.
+     * Every job writes into its own buffer and the finished chunks are handed to the consumer on the calling thread
+     * in the order the jobs were added. Only a limited number of chunks are kept around at once so memory usage
+     * stays bounded by the size of the largest chunks instead of the size of the whole output.
+     */
+    class ParallelDriver {
+    public:
+        using Job = std::function<void(OutputSink &sink)>;
+        using Consumer = std::function<void(size_t index, std::string_view output)>;
+
+        ParallelDriver(const PatternLanguage &runtime, u32 threadCount) : m_runtime(runtime), m_threadCount(std::max<u32>(threadCount, 1)) { }
+
+        size_t addJob(Job job) {
+            this->m_jobs.push_back(std::move(job));
+
+            return this->m_jobs.size() - 1;
+        }
+
+        [[nodiscard]] u32 getThreadCount() const {
+            return this->m_threadCount;
+        }
+
+        // Returns the pattern as an array if it has enough entries to be worth splitting up into multiple jobs
+        [[nodiscard]] static ptrn::IIterable *getSplittableArray(ptrn::Pattern *pattern) {
+            if (dynamic_cast<ptrn::PatternArrayStatic *>(pattern) == nullptr && dynamic_cast<ptrn::PatternArrayDynamic *>(pattern) == nullptr)
+                return nullptr;
+
+            auto array = dynamic_cast<ptrn::IIterable *>(pattern);
+            if (array->getEntryCount() <= ArrayRangeSize)
+                return nullptr;
+
+            return array;
+        }
+
+        // Static arrays reuse a single pattern for all of their entries. Ranges of them are iterated on a copy
+        // of the array so multiple ranges can be formatted at the same time
+        static void forEachArrayEntry(ptrn::Pattern *array, u64 start, u64 end, const std::function<void(u64, ptrn::Pattern *)> &callback) {
+            if (dynamic_cast<ptrn::PatternArrayStatic *>(array) != nullptr) {
+                auto copy = array->clone();
+                dynamic_cast<ptrn::IIterable *>(copy.get())->forEachEntry(start, end, callback);
+            } else {
+                dynamic_cast<ptrn::IIterable *>(array)->forEachEntry(start, end, callback);
+            }
+        }
+
+        constexpr static u64 ArrayRangeSize = 0x1000;
+
+        void run(const Consumer &consumer) {
+            auto &evaluator = *this->m_runtime.getInternals().evaluator;
+            evaluator.setConcurrentAccess(true);
+            ON_SCOPE_EXIT {
+                evaluator.setConcurrentAccess(false);
+                this->m_jobs.clear();
+            };
+
+            const size_t maxChunksInFlight = size_t(this->m_threadCount) * 4;
+
+            std::vector<std::string> chunks(this->m_jobs.size());
+            std::vector<bool> finished(this->m_jobs.size(), false);
+            size_t nextJob = 0, nextChunk = 0;
+            std::exception_ptr exception;
+
+            std::mutex mutex;
+            std::condition_variable stateChanged;
+
+            auto worker = [&] {
+                while (true) {
+                    size_t index;
+                    {
+                        std::unique_lock lock(mutex);
+                        stateChanged.wait(lock, [&] {
+                            return exception != nullptr || nextJob >= this->m_jobs.size() || nextJob < nextChunk + maxChunksInFlight;
+                        });
+
+                        if (exception != nullptr || nextJob >= this->m_jobs.size())
+                            return;
+
+                        index = nextJob++;
+                    }
+
+                    std::string output;
+                    try {
+                        OutputSink sink([&output](const u8 *data, size_t size) {
+                            output.append(reinterpret_cast<const char *>(data), size);
+                        });
+
+                        this->m_jobs[index](sink);
+                        sink.flush();
+                    } catch (...) {
+                        std::scoped_lock lock(mutex);
+                        if (exception == nullptr)
+                            exception = std::current_exception();
+                        stateChanged.notify_all();
+
+                        return;
+                    }
+
+                    {
+                        std::scoped_lock lock(mutex);
+                        chunks[index] = std::move(output);
+                        finished[index] = true;
+                    }
+                    stateChanged.notify_all();
+                }
+            };
+
+            {
+                std::vector<std::jthread> workers;
+                for (u32 i = 0; i < std::min<size_t>(this->m_threadCount, this->m_jobs.size()); i++)
+                    workers.emplace_back(worker);
+
+                std::unique_lock lock(mutex);
+                while (nextChunk < this->m_jobs.size()) {
+                    stateChanged.wait(lock, [&] { return exception != nullptr || finished[nextChunk]; });
+                    if (exception != nullptr)
+                        break;
+
+                    auto chunk = std::move(chunks[nextChunk]);
+                    const auto index = nextChunk;
+                    nextChunk += 1;
+                    stateChanged.notify_all();
+
+                    lock.unlock();
+                    try {
+                        consumer(index, chunk);
+                    } catch (...) {
+                        lock.lock();
+                        exception = std::current_exception();
+                        stateChanged.notify_all();
+                        break;
+                    }
+                    lock.lock();
+                }
+            }
+
+            if (exception != nullptr)
+                std::rethrow_exception(exception);
+        }
+
+    private:
+        const PatternLanguage &m_runtime;
+        u32 m_threadCount;
+        std::vector<Job> m_jobs;
+    };
+
+}
@@ -14,6 +14,7 @@ namespace pl {
     class PatternLanguage;
 
     namespace core { class Evaluator; }
+    namespace ptrn { class Pattern; }
 
 }
 
@@ -32,6 +33,16 @@ namespace pl::api {
         std::vector<u8> data;
     };
 
+    /**
+     * @brief A pattern overlapping a queried address range
+     * @note Patterns of array entries are shared between all entries. Their offset is not moved to the entry, use address instead
+     */
+    struct PatternRange {
+        u64 start, end;             // Part of the pattern inside the queried range, end is inclusive
+        u64 address;                // Address of the whole pattern
+        ptrn::Pattern *pattern;
+    };
+
     /**
      * @brief Type to pass to function register functions to specify the number of parameters a function takes.
      */
@@ -93,6 +104,7 @@ namespace pl::api {
         std::vector<core::Token::Literal> defaultParameters;
         FunctionCallback func;
         bool dangerous;
+        bool retainsParameters;     // Whether the function may keep references to its parameters after it returned
     };
 
 }
\ No newline at end of file
@@ -205,7 +205,8 @@ namespace pl::core::ast {
                         [](auto &&size) -> i128 { return size; }
                     }, literal->getValue());
                 } else if (auto whileStatement = dynamic_cast<ASTNodeWhileStatement *>(sizeNode.get())) {
-                    while (whileStatement->evaluateCondition(evaluator)) {
+                    auto condition = whileStatement->compileCondition(evaluator);
+                    while (condition.has_value() ? (*condition)(evaluator->getReadOffset()) : whileStatement->evaluateCondition(evaluator)) {
                         if (templatePattern->getSection() == ptrn::Pattern::MainSectionId)
                             if ((evaluator->getReadOffset() - evaluator->getDataBaseAddress()) > (evaluator->getDataSize() + 1))
                                 err::E0004.throwError("Array expanded past end of the data before termination condition was met.", { }, this);
@@ -219,8 +220,14 @@ namespace pl::core::ast {
                 if (entryCount < 0)
                     err::E0004.throwError("Array size cannot be negative.", { }, this);
             } else {
+                // Entries that lie entirely within the data are searched in bulk, the remaining ones one by one
                 std::vector<u8> buffer(templatePattern->getSize());
-                while (true) {
+
+                bool reachedEnd = false;
+                if (templatePattern->getSection() == ptrn::Pattern::MainSectionId && !evaluator->readOrderIsReversed() && !buffer.empty())
+                    reachedEnd = this->findNullEntry(evaluator, buffer.size(), entryCount);
+
+                while (!reachedEnd) {
                     if (templatePattern->getSection() == ptrn::Pattern::MainSectionId)
                         if ((evaluator->getReadOffset() - evaluator->getDataBaseAddress()) > (evaluator->getDataSize() + 1))
                             err::E0004.throwError("Array expanded past end of the data before a null-entry was found.", "Try using a while-sized array instead to limit the size of the array.", this);
@@ -230,7 +237,7 @@ namespace pl::core::ast {
 
                     entryCount++;
 
-                    bool reachedEnd = true;
+                    reachedEnd = true;
                     for (u8 &byte : buffer) {
                         if (byte != 0x00) {
                             reachedEnd = false;
@@ -275,6 +282,36 @@ namespace pl::core::ast {
             return outputPattern;
         }
 
+        // Searches the entries that lie entirely within the data for the first one that's all zeros, reading them in chunks.
+        // Returns true and advances past that entry if one was found, otherwise stops after the last searched entry
+        bool findNullEntry(Evaluator *evaluator, u64 entrySize, i128 &entryCount) const {
+            const u64 entriesPerChunk = std::max<u64>(NullEntryChunkSize / entrySize, 1);
+            std::vector<u8> buffer(entriesPerChunk * entrySize);
+
+            const auto dataEnd = evaluator->getDataBaseAddress() + evaluator->getDataSize();
+            while (true) {
+                const auto offset = evaluator->getReadOffset();
+                if (offset > dataEnd || dataEnd - offset < entrySize)
+                    return false;
+
+                const auto count = std::min(entriesPerChunk, (dataEnd - offset) / entrySize);
+                evaluator->readData(offset, buffer.data(), count * entrySize, ptrn::Pattern::MainSectionId);
+
+                if (auto index = hlp::findZeroEntry(buffer.data(), count, entrySize); index.has_value()) {
+                    evaluator->setReadOffset(offset + (*index + 1) * entrySize);
+                    entryCount += *index + 1;
+                    return true;
+                }
+
+                entryCount += count;
+                evaluator->setReadOffset(offset + count * entrySize);
+
+                evaluator->handleAbort();
+            }
+        }
+
+        constexpr static u64 NullEntryChunkSize = 0x10000;
+
         std::unique_ptr<ptrn::Pattern> createDynamicArray(Evaluator *evaluator) const {
             auto startArrayIndex = evaluator->getCurrentArrayIndex();
             ON_SCOPE_EXIT {
@@ -296,7 +333,7 @@ namespace pl::core::ast {
 
             auto addEntries = [&](std::vector<std::shared_ptr<ptrn::Pattern>> &&patterns) {
                 for (auto &pattern : patterns) {
-                    pattern->setVariableName(fmt::format("[{}]", entryIndex));
+                    pattern->setArrayIndex(entryIndex);
                     pattern->setEndian(arrayPattern->getEndian());
                     if (pattern->getSection() == ptrn::Pattern::MainSectionId)
                         pattern->setSection(arrayPattern->getSection());
@@ -329,7 +366,7 @@ namespace pl::core::ast {
 
                     auto limit = evaluator->getArrayLimit();
                     if (entryCount > limit)
-                        err::E0007.throwError(fmt::format("Array grew past set limit of {}", limit), "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
+                        err::E0007.throwError([limit] { return fmt::format("Array grew past set limit of {}", limit); }, "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
 
                     for (u64 i = 0; i < entryCount; i++) {
                         evaluator->setCurrentControlFlowStatement(ControlFlowStatement::None);
@@ -360,7 +397,7 @@ namespace pl::core::ast {
                     while (whileStatement->evaluateCondition(evaluator)) {
                         auto limit = evaluator->getArrayLimit();
                         if (entryIndex > limit)
-                            err::E0007.throwError(fmt::format("Array grew past set limit of {}", limit), "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
+                            err::E0007.throwError([limit] { return fmt::format("Array grew past set limit of {}", limit); }, "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
 
                         evaluator->setCurrentArrayIndex(entryIndex);
 
@@ -392,7 +429,7 @@ namespace pl::core::ast {
                     bool reachedEnd = true;
                     auto limit      = evaluator->getArrayLimit();
                     if (entryIndex > limit)
-                        err::E0007.throwError(fmt::format("Array grew past set limit of {}", limit), "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
+                        err::E0007.throwError([limit] { return fmt::format("Array grew past set limit of {}", limit); }, "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
 
                     evaluator->setCurrentArrayIndex(entryIndex);
 
@@ -98,7 +98,7 @@ namespace pl::core::ast {
 
             auto addEntries = [&](std::vector<std::shared_ptr<ptrn::Pattern>> &&patterns) {
                 for (auto &pattern : patterns) {
-                    pattern->setVariableName(fmt::format("[{}]", entryIndex));
+                    pattern->setArrayIndex(entryIndex);
                     pattern->setEndian(arrayPattern->getEndian());
                     if (pattern->getSection() == ptrn::Pattern::MainSectionId)
                         pattern->setSection(arrayPattern->getSection());
@@ -133,7 +133,7 @@ namespace pl::core::ast {
             auto limit = evaluator->getArrayLimit();
             auto checkLimit = [&](auto count) {
                 if (count > limit)
-                    err::E0007.throwError(fmt::format("Bitfield array grew past set limit of {}", limit), "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
+                    err::E0007.throwError([limit] { return fmt::format("Bitfield array grew past set limit of {}", limit); }, "If this is intended, try increasing the limit using '#pragma array_limit <new_limit>'.", this);
             };
 
             if (std::holds_alternative<u128>(boundsCondition))
@@ -98,7 +98,7 @@ namespace pl::core::ast {
             if (auto *patternEnum = dynamic_cast<ptrn::PatternEnum*>(pattern.get()); patternEnum != nullptr) {
                 auto bitfieldEnum = std::make_unique<ptrn::PatternBitfieldFieldEnum>(evaluator, byteOffset, bitOffset, bitSize);
                 bitfieldEnum->setTypeName(patternEnum->getTypeName());
-                bitfieldEnum->setEnumValues(patternEnum->getEnumValues());
+                bitfieldEnum->setValueTable(patternEnum->getValueTable());
                 result = std::move(bitfieldEnum);
             } else if (dynamic_cast<ptrn::PatternBoolean*>(pattern.get()) != nullptr) {
                 result = std::make_shared<ptrn::PatternBitfieldFieldBoolean>(evaluator, byteOffset, bitOffset, bitSize);
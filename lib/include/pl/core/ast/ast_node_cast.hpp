@@ -33,6 +33,14 @@ namespace pl::core::ast {
             return std::unique_ptr<ASTNode>(new ASTNodeCast(*this));
         }
 
+        [[nodiscard]] const std::unique_ptr<ASTNode> &getValue() const {
+            return this->m_value;
+        }
+
+        [[nodiscard]] const std::unique_ptr<ASTNode> &getType() const {
+            return this->m_type;
+        }
+
         [[nodiscard]] std::unique_ptr<ASTNode> evaluate(Evaluator *evaluator) const override {
             evaluator->updateRuntime(this);
 
@@ -22,6 +22,14 @@ namespace pl::core::ast {
             return std::unique_ptr<ASTNode>(new ASTNodeControlFlowStatement(*this));
         }
 
+        [[nodiscard]] ControlFlowStatement getType() const {
+            return this->m_type;
+        }
+
+        [[nodiscard]] const std::unique_ptr<ASTNode> &getReturnValue() const {
+            return this->m_rvalue;
+        }
+
         [[nodiscard]] std::vector<std::shared_ptr<ptrn::Pattern>> createPatterns(Evaluator *evaluator) const override {
             evaluator->updateRuntime(this);
 
@@ -2,6 +2,8 @@
 
 #include <pl/core/ast/ast_node.hpp>
 #include <pl/core/ast/ast_node_attribute.hpp>
+#include <pl/core/ast/ast_node_literal.hpp>
+#include <pl/core/ast/ast_node_mathematical_expression.hpp>
 
 #include <pl/patterns/pattern_enum.hpp>
 
@@ -17,6 +19,7 @@ namespace pl::core::ast {
                 this->m_entries[name] = { expr.first->clone(), expr.second->clone() };
             }
             this->m_underlyingType = other.m_underlyingType->clone();
+            this->m_valueTable = other.m_valueTable;
         }
 
         [[nodiscard]] std::unique_ptr<ASTNode> clone() const override {
@@ -37,7 +40,31 @@ namespace pl::core::ast {
 
             pattern->setSection(evaluator->getSectionId());
 
+            pattern->setValueTable(this->getValueTable(evaluator));
+
+            pattern->setSize(underlying->getSize());
+            pattern->setEndian(underlying->getEndian());
+
+            applyTypeAttributes(evaluator, this, pattern);
+
+            return hlp::moveToVector<std::shared_ptr<ptrn::Pattern>>(std::move(pattern));
+        }
+
+        [[nodiscard]] const std::map<std::string, std::pair<std::unique_ptr<ASTNode>, std::unique_ptr<ASTNode>>> &getEntries() const { return this->m_entries; }
+        void addEntry(const std::string &name, std::unique_ptr<ASTNode> &&minExpr, std::unique_ptr<ASTNode> &&maxExpr) {
+            this->m_entries[name] = { std::move(minExpr), std::move(maxExpr) };
+        }
+
+        [[nodiscard]] const std::unique_ptr<ASTNode> &getUnderlyingType() { return this->m_underlyingType; }
+
+    private:
+        // Enums whose values are all made up of constants only need to be evaluated once for all of their patterns
+        [[nodiscard]] std::shared_ptr<const ptrn::PatternEnum::ValueTable> getValueTable(Evaluator *evaluator) const {
+            if (this->m_valueTable != nullptr)
+                return this->m_valueTable;
+
             std::vector<ptrn::PatternEnum::EnumValue> enumEntries;
+            bool constant = true;
             for (const auto &[name, expr] : this->m_entries) {
                 auto &[min, max] = expr;
 
@@ -59,28 +86,33 @@ namespace pl::core::ast {
                     maxLiteral->getValue(),
                     name
                 });
+
+                constant = constant && isConstant(min.get()) && isConstant(max.get());
             }
 
-            pattern->setEnumValues(enumEntries);
+            auto valueTable = std::make_shared<const ptrn::PatternEnum::ValueTable>(std::move(enumEntries));
+            if (constant)
+                this->m_valueTable = valueTable;
 
-            pattern->setSize(underlying->getSize());
-            pattern->setEndian(underlying->getEndian());
+            return valueTable;
+        }
 
-            applyTypeAttributes(evaluator, this, pattern);
+        [[nodiscard]] static bool isConstant(const ASTNode *node) {
+            if (dynamic_cast<const ASTNodeLiteral *>(node) != nullptr)
+                return true;
 
-            return hlp::moveToVector<std::shared_ptr<ptrn::Pattern>>(std::move(pattern));
-        }
+            if (auto expression = dynamic_cast<const ASTNodeMathematicalExpression *>(node); expression != nullptr)
+                return expression->getLeftOperand() != nullptr && expression->getRightOperand() != nullptr &&
+                       isConstant(expression->getLeftOperand().get()) && isConstant(expression->getRightOperand().get());
 
-        [[nodiscard]] const std::map<std::string, std::pair<std::unique_ptr<ASTNode>, std::unique_ptr<ASTNode>>> &getEntries() const { return this->m_entries; }
-        void addEntry(const std::string &name, std::unique_ptr<ASTNode> &&minExpr, std::unique_ptr<ASTNode> &&maxExpr) {
-            this->m_entries[name] = { std::move(minExpr), std::move(maxExpr) };
+            return false;
         }
 
-        [[nodiscard]] const std::unique_ptr<ASTNode> &getUnderlyingType() { return this->m_underlyingType; }
-
     private:
         std::map<std::string, std::pair<std::unique_ptr<ASTNode>, std::unique_ptr<ASTNode>>> m_entries;
         std::unique_ptr<ASTNode> m_underlyingType;
+
+        mutable std::shared_ptr<const ptrn::PatternEnum::ValueTable> m_valueTable;
     };
 
 }
\ No newline at end of file
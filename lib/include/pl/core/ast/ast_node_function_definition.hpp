@@ -68,6 +68,7 @@ namespace pl::core::ast {
                 }
             }
 
+            evaluator->addCustomFunctionDefinition(this->m_name, this);
             evaluator->addCustomFunction(this->m_name, paramCount, evaluatedDefaultParams, [this](Evaluator *ctx, const std::vector<Token::Literal> &params) -> std::optional<Token::Literal> {
                 std::vector<std::shared_ptr<ptrn::Pattern>> variables;
 
@@ -135,7 +136,7 @@ namespace pl::core::ast {
                 }
 
                 return {};
-            });
+            }, this->retainsParameters());
 
             return nullptr;
         }
@@ -149,6 +150,27 @@ namespace pl::core::ast {
         }
 
 
+    private:
+        // Parameters with a concrete type are copied into a new variable when the function is called.
+        // Only auto parameters and parameter packs keep using the passed patterns themselves
+        [[nodiscard]] bool retainsParameters() const {
+            if (this->m_parameterPack.has_value())
+                return true;
+
+            for (const auto &[name, type] : this->m_params) {
+                const ASTNode *node = type.get();
+                while (auto typeDecl = dynamic_cast<const ASTNodeTypeDecl *>(node))
+                    node = typeDecl->getType().get();
+
+                if (node == nullptr)
+                    return true;
+                if (auto builtinType = dynamic_cast<const ASTNodeBuiltinType *>(node); builtinType != nullptr && builtinType->getType() == Token::ValueType::Auto)
+                    return true;
+            }
+
+            return false;
+        }
+
     private:
         std::string m_name;
         std::vector<std::pair<std::string, std::unique_ptr<ASTNode>>> m_params;
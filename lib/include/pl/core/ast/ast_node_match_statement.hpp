@@ -3,6 +3,11 @@
 #include <pl/core/ast/ast_node.hpp>
 #include <pl/core/ast/ast_node_literal.hpp>
 #include <pl/core/ast/ast_node_mathematical_expression.hpp>
+#include <pl/core/ast/ast_node_rvalue.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <set>
 #include <utility>
 
 namespace pl::core::ast {
@@ -85,13 +90,17 @@ namespace pl::core::ast {
 
             auto &currScope = evaluator->getScope(0);
 
-            auto variables     = *currScope.scope;
+            // The body shares the variables of the surrounding scope, the ones it declares itself are removed again afterwards
+            auto &variables    = *currScope.scope;
+            auto variableCount = variables.size();
             auto parameterPack = currScope.parameterPack;
 
             evaluator->pushScope(nullptr, variables);
             evaluator->getScope(0).parameterPack = parameterPack;
             ON_SCOPE_EXIT {
                 evaluator->popScope();
+                if (variables.size() > variableCount)
+                    variables.resize(variableCount);
             };
 
             for (auto &statement : *body) {
@@ -136,14 +145,22 @@ namespace pl::core::ast {
 
         [[nodiscard]] const std::vector<std::unique_ptr<ASTNode>>* getCaseBody(Evaluator *evaluator) const {
             std::optional<size_t> matchedBody;
-            for (size_t i = 0; i < this->m_cases.size(); i++) {
-                auto &condition = this->m_cases[i].condition;
-                if (evaluateCondition(condition, evaluator)) {
-                    if(matchedBody.has_value())
-                        err::E0013.throwError(fmt::format("Match is ambiguous. Both case {} and {} match.", matchedBody.value() + 1, i + 1), {}, condition.get());
-                    matchedBody = i;
+            if (auto target = this->findJumpTarget(evaluator); target.has_value()) {
+                if (target->second != JumpTable::NoCase)
+                    err::E0013.throwError([first = target->first + 1, second = target->second + 1] { return fmt::format("Match is ambiguous. Both case {} and {} match.", first, second); }, {}, this->m_cases[target->second].condition.get());
+                if (target->first != JumpTable::NoCase)
+                    matchedBody = target->first;
+            } else {
+                for (size_t i = 0; i < this->m_cases.size(); i++) {
+                    auto &condition = this->m_cases[i].condition;
+                    if (evaluateCondition(condition, evaluator)) {
+                        if(matchedBody.has_value())
+                            err::E0013.throwError([first = matchedBody.value() + 1, second = i + 1] { return fmt::format("Match is ambiguous. Both case {} and {} match.", first, second); }, {}, condition.get());
+                        matchedBody = i;
+                    }
                 }
             }
+
             if (matchedBody.has_value())
                 return &this->m_cases[matchedBody.value()].body;
             // if no found, then attempt to use default case
@@ -152,7 +169,303 @@ namespace pl::core::ast {
             return nullptr;
         }
 
+        /*
+         * Sorted, non-overlapping ranges of values with the first two cases that match each of them.
+         * Signed values are biased into the unsigned range first so both keep their order. Small tables are
+         * additionally expanded into an array that's indexed directly by the value.
+         */
+        class JumpTable {
+        public:
+            constexpr static u32 NoCase = std::numeric_limits<u32>::max();
+
+            struct Target {
+                u32 first, second;
+
+                [[nodiscard]] bool operator==(const Target &other) const = default;
+            };
+
+            struct Range {
+                u128 start, end;
+                u32 caseIndex;
+            };
+
+            explicit JumpTable(const std::vector<Range> &caseRanges) {
+                struct Event {
+                    u128 position;
+                    bool remove;
+                    u32 caseIndex;
+                };
+
+                std::vector<Event> events;
+                for (const auto &range : caseRanges) {
+                    if (range.start > range.end)
+                        continue;
+
+                    events.push_back({ range.start, false, range.caseIndex });
+                    if (range.end != std::numeric_limits<u128>::max())
+                        events.push_back({ range.end + 1, true, range.caseIndex });
+                }
+
+                std::sort(events.begin(), events.end(), [](const Event &left, const Event &right) {
+                    return left.position < right.position;
+                });
+
+                std::multiset<u32> active;
+                for (size_t i = 0; i < events.size();) {
+                    const auto position = events[i].position;
+                    for (; i < events.size() && events[i].position == position; i++) {
+                        if (events[i].remove)
+                            active.erase(active.find(events[i].caseIndex));
+                        else
+                            active.insert(events[i].caseIndex);
+                    }
+
+                    if (active.empty())
+                        continue;
+
+                    const auto end = i < events.size() ? events[i].position - 1 : std::numeric_limits<u128>::max();
+                    const auto second = active.upper_bound(*active.begin());
+                    const Target target = { *active.begin(), second == active.end() ? NoCase : *second };
+
+                    if (!this->m_ranges.empty() && this->m_ranges.back().target == target && this->m_ranges.back().end + 1 == position)
+                        this->m_ranges.back().end = end;
+                    else
+                        this->m_ranges.push_back({ position, end, target });
+                }
+
+                if (this->m_ranges.empty())
+                    return;
+
+                const auto span = this->m_ranges.back().end - this->m_ranges.front().start;
+                if (span < std::max<u128>(MinDenseTableSize, u128(this->m_ranges.size()) * 4)) {
+                    this->m_denseStart = this->m_ranges.front().start;
+                    this->m_denseRanges.resize(size_t(span + 1), NoRange);
+                    for (u32 i = 0; i < this->m_ranges.size(); i++) {
+                        const auto &range = this->m_ranges[i];
+                        std::fill(this->m_denseRanges.begin() + size_t(range.start - this->m_denseStart), this->m_denseRanges.begin() + size_t(range.end - this->m_denseStart) + 1, i);
+                    }
+                }
+            }
+
+            [[nodiscard]] Target find(u128 value) const {
+                if (!this->m_denseRanges.empty()) {
+                    if (value < this->m_denseStart || value - this->m_denseStart >= this->m_denseRanges.size())
+                        return { NoCase, NoCase };
+
+                    const auto index = this->m_denseRanges[size_t(value - this->m_denseStart)];
+                    return index == NoRange ? Target { NoCase, NoCase } : this->m_ranges[index].target;
+                }
+
+                auto it = std::upper_bound(this->m_ranges.begin(), this->m_ranges.end(), value, [](u128 value, const TargetRange &range) {
+                    return value < range.start;
+                });
+
+                if (it == this->m_ranges.begin() || value > (--it)->end)
+                    return { NoCase, NoCase };
+
+                return it->target;
+            }
+
+        private:
+            constexpr static u32 NoRange = std::numeric_limits<u32>::max();
+            constexpr static u128 MinDenseTableSize = 0x100;
+
+            struct TargetRange {
+                u128 start, end;
+                Target target;
+            };
+
+            std::vector<TargetRange> m_ranges;
+
+            u128 m_denseStart = 0;
+            std::vector<u32> m_denseRanges;
+        };
+
+        struct CaseValues {
+            Token::Literal min, max;
+            u32 caseIndex;
+        };
+
+        // Matches over a single value whose cases only consist of integer constants and ranges of them
+        struct CompiledMatch {
+            const ASTNode *value;
+            std::vector<CaseValues> caseValues;
+            std::optional<JumpTable> unsignedTable, signedTable;
+        };
+
+        constexpr static u128 SignBias = u128(1) << 127;
+
+        [[nodiscard]] std::optional<JumpTable::Target> findJumpTarget(Evaluator *evaluator) const {
+            if (evaluator->isDebugModeEnabled() || !evaluator->getBreakpoints().empty())
+                return std::nullopt;
+
+            if (!this->m_compiled) {
+                this->m_compiledMatch = compileMatch(evaluator);
+                this->m_compiled = true;
+            }
+
+            if (this->m_compiledMatch == nullptr)
+                return std::nullopt;
+
+            auto &compiled = *this->m_compiledMatch;
+            const auto node = compiled.value->evaluate(evaluator);
+            const auto literal = dynamic_cast<ASTNodeLiteral *>(node.get());
+            if (literal == nullptr)
+                return std::nullopt;
+
+            // The values are compared the same way the mathematical expressions of the cases would compare them
+            auto lookup = [&](bool isSigned, u128 value) -> JumpTable::Target {
+                auto &table = isSigned ? compiled.signedTable : compiled.unsignedTable;
+                if (!table.has_value()) {
+                    std::vector<JumpTable::Range> ranges;
+                    for (const auto &[min, max, caseIndex] : compiled.caseValues) {
+                        if (isSigned)
+                            ranges.push_back({ u128(min.toSigned()) ^ SignBias, u128(max.toSigned()) ^ SignBias, caseIndex });
+                        else
+                            ranges.push_back({ min.toUnsigned(), max.toUnsigned(), caseIndex });
+                    }
+
+                    table.emplace(ranges);
+                }
+
+                return table->find(isSigned ? value ^ SignBias : value);
+            };
+
+            return std::visit(wolv::util::overloaded {
+                [&](u128 value) -> std::optional<JumpTable::Target> { return lookup(false, value); },
+                [&](i128 value) -> std::optional<JumpTable::Target> { return lookup(true, u128(value)); },
+                [&](const std::shared_ptr<ptrn::Pattern> &pattern) -> std::optional<JumpTable::Target> {
+                    const auto value = pattern->getValue();
+                    if (!std::holds_alternative<u128>(value) && !std::holds_alternative<i128>(value))
+                        return std::nullopt;
+
+                    // Patterns are converted to the type of the value they're compared with
+                    const auto isUnsigned = [](const CaseValues &values) { return std::holds_alternative<u128>(values.min) && std::holds_alternative<u128>(values.max); };
+                    const auto isSigned = [](const CaseValues &values) {
+                        return !std::holds_alternative<u128>(values.min) && !std::holds_alternative<bool>(values.min) &&
+                               !std::holds_alternative<u128>(values.max) && !std::holds_alternative<bool>(values.max);
+                    };
+
+                    if (std::ranges::all_of(compiled.caseValues, isUnsigned))
+                        return lookup(false, value.toUnsigned());
+                    if (std::ranges::all_of(compiled.caseValues, isSigned))
+                        return lookup(true, u128(value.toSigned()));
+
+                    return std::nullopt;
+                },
+                [](const auto &) -> std::optional<JumpTable::Target> { return std::nullopt; }
+            }, literal->getValue());
+        }
+
+        [[nodiscard]] std::unique_ptr<CompiledMatch> compileMatch(Evaluator *evaluator) const {
+            if (this->m_cases.empty() || this->m_cases.size() >= JumpTable::NoCase)
+                return nullptr;
+
+            auto compiled = std::make_unique<CompiledMatch>();
+            for (u32 i = 0; i < this->m_cases.size(); i++) {
+                if (!compileCase(evaluator, this->m_cases[i].condition.get(), i, *compiled))
+                    return nullptr;
+            }
+
+            return compiled;
+        }
+
+        // Cases are made up of 'value == constant' and 'value >= min && value <= max' conditions joined by ||
+        [[nodiscard]] static bool compileCase(Evaluator *evaluator, const ASTNode *condition, u32 caseIndex, CompiledMatch &compiled) {
+            const auto expression = dynamic_cast<const ASTNodeMathematicalExpression *>(condition);
+            if (expression == nullptr)
+                return false;
+
+            const auto left = expression->getLeftOperand().get(), right = expression->getRightOperand().get();
+            if (left == nullptr || right == nullptr)
+                return false;
+
+            switch (expression->getOperator()) {
+                case Token::Operator::BoolOr:
+                    return compileCase(evaluator, left, caseIndex, compiled) && compileCase(evaluator, right, caseIndex, compiled);
+                case Token::Operator::BoolEqual: {
+                    auto constant = evaluateConstant(evaluator, right);
+                    if (!isMatchedValue(left, compiled) || !constant.has_value())
+                        return false;
+
+                    compiled.caseValues.push_back({ *constant, *constant, caseIndex });
+                    return true;
+                }
+                case Token::Operator::BoolAnd: {
+                    const auto lower = dynamic_cast<const ASTNodeMathematicalExpression *>(left);
+                    const auto upper = dynamic_cast<const ASTNodeMathematicalExpression *>(right);
+                    if (lower == nullptr || upper == nullptr || lower->getOperator() != Token::Operator::BoolGreaterThanOrEqual || upper->getOperator() != Token::Operator::BoolLessThanOrEqual)
+                        return false;
+                    if (!isMatchedValue(lower->getLeftOperand().get(), compiled) || !isMatchedValue(upper->getLeftOperand().get(), compiled))
+                        return false;
+
+                    auto min = evaluateConstant(evaluator, lower->getRightOperand().get());
+                    auto max = evaluateConstant(evaluator, upper->getRightOperand().get());
+                    if (!min.has_value() || !max.has_value())
+                        return false;
+
+                    compiled.caseValues.push_back({ *min, *max, caseIndex });
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        // Only plain variables are supported so reading them once instead of once per case doesn't change anything
+        [[nodiscard]] static bool isMatchedValue(const ASTNode *node, CompiledMatch &compiled) {
+            const auto rvalue = dynamic_cast<const ASTNodeRValue *>(node);
+            if (rvalue == nullptr || rvalue->getPath().empty())
+                return false;
+
+            const auto isName = [](const ASTNodeRValue::PathSegment &segment) { return std::holds_alternative<std::string>(segment); };
+            if (!std::ranges::all_of(rvalue->getPath(), isName))
+                return false;
+
+            if (compiled.value == nullptr) {
+                compiled.value = node;
+                return true;
+            }
+
+            const auto &path = dynamic_cast<const ASTNodeRValue *>(compiled.value)->getPath();
+            return std::ranges::equal(rvalue->getPath(), path, [](const auto &left, const auto &right) {
+                return std::get<std::string>(left) == std::get<std::string>(right);
+            });
+        }
+
+        [[nodiscard]] static bool isConstant(const ASTNode *node) {
+            if (node == nullptr)
+                return false;
+
+            if (dynamic_cast<const ASTNodeLiteral *>(node) != nullptr)
+                return true;
+
+            if (auto expression = dynamic_cast<const ASTNodeMathematicalExpression *>(node); expression != nullptr)
+                return isConstant(expression->getLeftOperand().get()) && isConstant(expression->getRightOperand().get());
+
+            return false;
+        }
+
+        [[nodiscard]] static std::optional<Token::Literal> evaluateConstant(Evaluator *evaluator, const ASTNode *node) {
+            if (!isConstant(node))
+                return std::nullopt;
+
+            auto result = node->evaluate(evaluator);
+            auto literal = dynamic_cast<ASTNodeLiteral *>(result.get());
+            if (literal == nullptr)
+                return std::nullopt;
+
+            const auto &value = literal->getValue();
+            if (!std::holds_alternative<u128>(value) && !std::holds_alternative<i128>(value) && !std::holds_alternative<char>(value) && !std::holds_alternative<bool>(value))
+                return std::nullopt;
+
+            return value;
+        }
+
         std::vector<MatchCase> m_cases;
         std::optional<MatchCase> m_defaultCase;
+
+        mutable bool m_compiled = false;
+        mutable std::unique_ptr<CompiledMatch> m_compiledMatch;
     };
 }
\ No newline at end of file
@@ -218,7 +218,7 @@ namespace pl::core::ast {
                             err::E0003.throwError("Invalid use of 'null' keyword in rvalue.", {}, this);
 
                         if (!found)
-                            err::E0003.throwError(fmt::format("No variable named '{}' found.", name), {}, this);
+                            err::E0003.throwError([name] { return fmt::format("No variable named '{}' found.", name); }, {}, this);
                     }
                 } else {
                     // Array indexing
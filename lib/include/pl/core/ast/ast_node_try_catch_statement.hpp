@@ -43,6 +43,8 @@ namespace pl::core::ast {
                         break;
                 }
             } catch (err::EvaluatorError::Exception &error) {
+                evaluator->getStatistics().evaluationErrors++;
+
                 evaluator->setReadOffset(startOffset);
 
                 scope.scope->resize(startScopeSize);
@@ -99,6 +101,8 @@ namespace pl::core::ast {
                     }
                 }
             } catch (err::EvaluatorError::Exception &error) {
+                evaluator->getStatistics().evaluationErrors++;
+
                 for (auto &statement : this->m_catchBody) {
                     auto result = statement->execute(evaluator);
 
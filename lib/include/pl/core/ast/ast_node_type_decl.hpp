@@ -92,6 +92,15 @@ namespace pl::core::ast {
                 }
             }
 
+            auto &memoryProfiler = evaluator->getMemoryProfiler();
+            const bool profileMemory = memoryProfiler.isEnabled() && !this->m_name.empty();
+            if (profileMemory) [[unlikely]]
+                memoryProfiler.pushSite(this->m_name, this->getLine());
+            ON_SCOPE_EXIT {
+                if (profileMemory) [[unlikely]]
+                    memoryProfiler.popSite();
+            };
+
             evaluator->pushTemplateParameters();
             ON_SCOPE_EXIT {
                 evaluator->popTemplateParameters();
@@ -72,7 +72,7 @@ namespace pl::core::ast {
                 offset->getValue()));
 
                 if (evaluator->getReadOffset() < evaluator->getDataBaseAddress() || evaluator->getReadOffset() > evaluator->getDataBaseAddress() + evaluator->getDataSize())
-                    err::E0005.throwError(fmt::format("Cannot place variable '{}' at out of bounds address 0x{:08X}", this->m_name, evaluator->getReadOffset()), { }, this);
+                    err::E0005.throwError([name = this->m_name, address = evaluator->getReadOffset()] { return fmt::format("Cannot place variable '{}' at out of bounds address 0x{:08X}", name, address); }, { }, this);
             }
 
             if (evaluator->getSectionId() == ptrn::Pattern::PatternLocalSectionId || evaluator->getSectionId() == ptrn::Pattern::HeapSectionId) {
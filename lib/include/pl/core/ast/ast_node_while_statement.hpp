@@ -1,7 +1,19 @@
 #pragma once
 
 #include <pl/core/ast/ast_node.hpp>
+#include <pl/core/ast/ast_node_builtin_type.hpp>
+#include <pl/core/ast/ast_node_cast.hpp>
+#include <pl/core/ast/ast_node_control_flow_statement.hpp>
 #include <pl/core/ast/ast_node_literal.hpp>
+#include <pl/core/ast/ast_node_rvalue.hpp>
+#include <pl/core/ast/ast_node_scope_resolution.hpp>
+#include <pl/core/ast/ast_node_function_call.hpp>
+#include <pl/core/ast/ast_node_function_definition.hpp>
+#include <pl/core/ast/ast_node_mathematical_expression.hpp>
+#include <pl/core/ast/ast_node_type_decl.hpp>
+
+#include <cstring>
+#include <functional>
 
 namespace pl::core::ast {
 
@@ -68,7 +80,7 @@ namespace pl::core::ast {
 
                 loopIterations++;
                 if (loopIterations >= evaluator->getLoopLimit())
-                    err::E0007.throwError(fmt::format("Loop iterations exceeded set limit of {}", evaluator->getLoopLimit()), "If this is intended, try increasing the limit using '#pragma loop_limit <new_limit>'.");
+                    err::E0007.throwError([limit = evaluator->getLoopLimit()] { return fmt::format("Loop iterations exceeded set limit of {}", limit); }, "If this is intended, try increasing the limit using '#pragma loop_limit <new_limit>'.");
 
                 evaluator->handleAbort();
 
@@ -96,6 +108,434 @@ namespace pl::core::ast {
             }, literal->getValue());
         }
 
+        // Condition compiled to a native predicate of the current read offset
+        using NativeCondition = std::function<bool(u64)>;
+
+        // Compiles conditions that only depend on the read offset and on the data at fixed distances from it, like
+        // `$ < end` or `std::mem::read_unsigned($, 4) != 0xFFFFFFFF`. Everything else in the condition has to be
+        // constant, it's evaluated once here. Returns std::nullopt for conditions that need to be interpreted
+        [[nodiscard]] std::optional<NativeCondition> compileCondition(Evaluator *evaluator) const {
+            if (evaluator->isDebugModeEnabled() || !evaluator->getBreakpoints().empty())
+                return std::nullopt;
+
+            auto window = std::make_shared<DataWindow>(evaluator);
+            return compilePredicate(evaluator, window, this->getCondition().get());
+        }
+
+    private:
+        // Keeps a block of the data around the last read so the predicates don't need to go through the reader for every value
+        class DataWindow {
+        public:
+            explicit DataWindow(Evaluator *evaluator) : m_evaluator(evaluator) { }
+
+            [[nodiscard]] u128 read(u64 address, u8 size, std::endian endian) {
+                u128 result = 0;
+
+                if (address < this->m_start || address - this->m_start + size > this->m_bytes.size()) {
+                    const auto dataStart = this->m_evaluator->getDataBaseAddress();
+                    const auto dataEnd   = dataStart + this->m_evaluator->getDataSize();
+
+                    // Values that aren't entirely within the data are read exactly like std::mem::read_unsigned reads them
+                    if (address < dataStart || address >= dataEnd || dataEnd - address < size) {
+                        this->m_evaluator->readData(address, &result, size, ptrn::Pattern::MainSectionId);
+                        return hlp::changeEndianess(result, size, endian);
+                    }
+
+                    // Most while-arrays are short, so the window starts small and only grows for the ones that keep on reading
+                    this->m_start = address - std::min<u64>(address - dataStart, std::min(LookBehindSize, this->m_windowSize / 4));
+                    this->m_bytes.resize(std::min<u64>(this->m_windowSize, dataEnd - this->m_start));
+                    this->m_evaluator->readData(this->m_start, this->m_bytes.data(), this->m_bytes.size(), ptrn::Pattern::MainSectionId);
+
+                    this->m_windowSize = std::min(this->m_windowSize * 2, MaxWindowSize);
+                }
+
+                std::memcpy(&result, this->m_bytes.data() + (address - this->m_start), size);
+                return hlp::changeEndianess(result, size, endian);
+            }
+
+        private:
+            constexpr static u64 MinWindowSize  = 0x40;
+            constexpr static u64 MaxWindowSize  = 0x10000;
+            constexpr static u64 LookBehindSize = 0x100;
+
+            Evaluator *m_evaluator;
+            u64 m_start = 0;
+            u64 m_windowSize = MinWindowSize;
+            std::vector<u8> m_bytes;
+        };
+
+        // Either a value computed from the read offset or a constant
+        struct CompiledValue {
+            std::function<u128(u64)> compute;
+            std::optional<Token::Literal> constant;
+        };
+
+        // Address relative to the read offset or an absolute one
+        struct CompiledAddress {
+            bool relative;
+            u64 displacement;
+        };
+
+        [[nodiscard]] static bool isVariable(const ASTNode *node, const std::string &variableName) {
+            auto rvalue = dynamic_cast<const ASTNodeRValue *>(node);
+            if (rvalue == nullptr || rvalue->getPath().size() != 1)
+                return false;
+
+            auto name = std::get_if<std::string>(&rvalue->getPath().front());
+            return name != nullptr && *name == variableName;
+        }
+
+        [[nodiscard]] static bool isOffset(const ASTNode *node) {
+            return isVariable(node, "$");
+        }
+
+        // Nodes that evaluate to the same value on every iteration
+        [[nodiscard]] static bool isInvariant(const ASTNode *node) {
+            if (node == nullptr)
+                return false;
+
+            // Literals and enum constants like std::mem::Endian::Big
+            if (dynamic_cast<const ASTNodeLiteral *>(node) != nullptr || dynamic_cast<const ASTNodeScopeResolution *>(node) != nullptr)
+                return true;
+
+            if (auto rvalue = dynamic_cast<const ASTNodeRValue *>(node); rvalue != nullptr) {
+                const auto &path = rvalue->getPath();
+                if (path.empty())
+                    return false;
+                if (auto name = std::get_if<std::string>(&path.front()); name == nullptr || *name == "$")
+                    return false;
+
+                return std::ranges::all_of(path, [](const ASTNodeRValue::PathSegment &segment) {
+                    auto index = std::get_if<std::unique_ptr<ASTNode>>(&segment);
+                    return index == nullptr || isInvariant(index->get());
+                });
+            }
+
+            if (auto expression = dynamic_cast<const ASTNodeMathematicalExpression *>(node); expression != nullptr)
+                return isInvariant(expression->getLeftOperand().get()) && isInvariant(expression->getRightOperand().get());
+
+            return false;
+        }
+
+        [[nodiscard]] static std::optional<Token::Literal> evaluateConstant(Evaluator *evaluator, const ASTNode *node) {
+            auto result = node->evaluate(evaluator);
+            if (auto literal = dynamic_cast<ASTNodeLiteral *>(result.get()); literal != nullptr)
+                return literal->getValue();
+            else
+                return std::nullopt;
+        }
+
+        // Integer constants the same way the interpreter converts them when comparing them to an unsigned value
+        [[nodiscard]] static std::optional<u128> toInteger(const Token::Literal &literal, bool allowPatterns) {
+            if (auto pattern = std::get_if<std::shared_ptr<ptrn::Pattern>>(&literal); pattern != nullptr) {
+                if (!allowPatterns)
+                    return std::nullopt;
+
+                return toInteger((*pattern)->getValue(), false);
+            }
+
+            if (auto value = std::get_if<u128>(&literal); value != nullptr)
+                return *value;
+            if (auto value = std::get_if<i128>(&literal); value != nullptr)
+                return u128(*value);
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] static std::optional<std::endian> toEndian(const Token::Literal &literal, bool allowPatterns) {
+            switch (toInteger(literal, allowPatterns).value_or(~u128(0))) {
+                case 0: return std::endian::native;
+                case 1: return std::endian::big;
+                case 2: return std::endian::little;
+                default: return std::nullopt;
+            }
+        }
+
+        [[nodiscard]] static std::optional<CompiledAddress> compileAddress(Evaluator *evaluator, const ASTNode *node) {
+            if (isOffset(node))
+                return CompiledAddress { true, 0 };
+
+            if (isInvariant(node)) {
+                auto constant = evaluateConstant(evaluator, node);
+                if (auto address = constant.and_then([](const auto &value) { return toInteger(value, false); }); address.has_value())
+                    return CompiledAddress { false, u64(*address) };
+                return std::nullopt;
+            }
+
+            // $ + n, n + $ and $ - n
+            auto expression = dynamic_cast<const ASTNodeMathematicalExpression *>(node);
+            if (expression == nullptr)
+                return std::nullopt;
+
+            const auto left = expression->getLeftOperand().get(), right = expression->getRightOperand().get();
+            const ASTNode *displacementNode = nullptr;
+            if (expression->getOperator() == Token::Operator::Plus && isOffset(left))
+                displacementNode = right;
+            else if (expression->getOperator() == Token::Operator::Plus && isOffset(right))
+                displacementNode = left;
+            else if (expression->getOperator() == Token::Operator::Minus && isOffset(left))
+                displacementNode = right;
+
+            if (!isInvariant(displacementNode))
+                return std::nullopt;
+
+            auto displacement = evaluateConstant(evaluator, displacementNode).and_then([](const auto &value) { return toInteger(value, false); });
+            if (!displacement.has_value())
+                return std::nullopt;
+
+            if (expression->getOperator() == Token::Operator::Minus)
+                return CompiledAddress { true, u64(0) - u64(*displacement) };
+            else
+                return CompiledAddress { true, u64(*displacement) };
+        }
+
+        [[nodiscard]] static std::optional<CompiledValue> compileRead(const std::shared_ptr<DataWindow> &window, CompiledAddress address, u8 size, std::endian endian) {
+            return CompiledValue {
+                [window, address, size, endian](u64 offset) {
+                    return window->read((address.relative ? offset : 0) + address.displacement, size, endian);
+                },
+                std::nullopt
+            };
+        }
+
+        [[nodiscard]] static std::optional<Token::ValueType> getBuiltinType(const ASTNode *node) {
+            while (auto typeDecl = dynamic_cast<const ASTNodeTypeDecl *>(node))
+                node = typeDecl->getType().get();
+
+            if (auto builtinType = dynamic_cast<const ASTNodeBuiltinType *>(node); builtinType != nullptr)
+                return builtinType->getType();
+            else
+                return std::nullopt;
+        }
+
+        // Only accepts functions that pass their parameters on to the builtin unchanged, the way the std library defines it:
+        // fn read_unsigned(u128 address, u8 size, Endian endian = Endian::Native) { return builtin::std::mem::read_unsigned(address, size, u32(endian)); };
+        [[nodiscard]] static bool isForwardToBuiltin(const ASTNodeFunctionDefinition *definition, const std::string &builtinName) {
+            if (definition == nullptr || definition->getParameterPack().has_value() || definition->getParams().size() != 3 || definition->getBody().size() != 1)
+                return false;
+
+            auto statement = dynamic_cast<const ASTNodeControlFlowStatement *>(definition->getBody().front().get());
+            if (statement == nullptr || statement->getType() != ControlFlowStatement::Return)
+                return false;
+
+            auto call = dynamic_cast<const ASTNodeFunctionCall *>(statement->getReturnValue().get());
+            if (call == nullptr || call->getFunctionName() != builtinName || call->getParams().size() != 3)
+                return false;
+
+            const auto &definitionParams = definition->getParams();
+            const auto &callParams       = call->getParams();
+
+            // Parameter types that would change the passed values, like an address that gets truncated, are rejected
+            auto isIntegerType = [](std::optional<Token::ValueType> type, u32 minSize, bool allowOtherTypes) {
+                if (!type.has_value())
+                    return allowOtherTypes;
+
+                return *type == Token::ValueType::Auto || (Token::isInteger(*type) && Token::getTypeSize(*type) >= minSize);
+            };
+
+            const auto addressType = getBuiltinType(definitionParams[0].second.get());
+            if (!isIntegerType(addressType, sizeof(u64), false) || (addressType != Token::ValueType::Auto && !Token::isUnsigned(*addressType)))
+                return false;
+            if (!isIntegerType(getBuiltinType(definitionParams[1].second.get()), 1, false))
+                return false;
+            if (!isIntegerType(getBuiltinType(definitionParams[2].second.get()), 1, true))
+                return false;
+
+            // The endian may be converted to an integer before it's passed on
+            const ASTNode *endianParam = callParams[2].get();
+            if (auto cast = dynamic_cast<const ASTNodeCast *>(endianParam); cast != nullptr) {
+                if (!isIntegerType(getBuiltinType(cast->getType().get()), 1, false))
+                    return false;
+
+                endianParam = cast->getValue().get();
+            }
+
+            return isVariable(callParams[0].get(), definitionParams[0].first) &&
+                   isVariable(callParams[1].get(), definitionParams[1].first) &&
+                   isVariable(endianParam, definitionParams[2].first);
+        }
+
+        [[nodiscard]] static std::optional<CompiledValue> compileReadUnsigned(Evaluator *evaluator, const std::shared_ptr<DataWindow> &window, const ASTNodeFunctionCall *call) {
+            constexpr static auto BuiltinName = "builtin::std::mem::read_unsigned";
+            constexpr static auto StdName     = "std::mem::read_unsigned";
+
+            const auto &name   = call->getFunctionName();
+            const auto &params = call->getParams();
+            const auto &customFunctions = evaluator->getCustomFunctions();
+
+            const bool isBuiltin = name == BuiltinName && params.size() == 3 && !customFunctions.contains(name) && evaluator->getBuiltinFunctions().contains(name);
+            const bool isStd     = name == StdName && (params.size() == 2 || params.size() == 3) && customFunctions.contains(name) &&
+                                   !customFunctions.contains(BuiltinName) && isForwardToBuiltin(evaluator->getCustomFunctionDefinition(name), BuiltinName);
+            if (!isBuiltin && !isStd)
+                return std::nullopt;
+
+            for (size_t i = 1; i < params.size(); i++) {
+                if (!isInvariant(params[i].get()))
+                    return std::nullopt;
+            }
+
+            auto address = compileAddress(evaluator, params[0].get());
+            auto size    = evaluateConstant(evaluator, params[1].get()).and_then([](const auto &value) { return toInteger(value, false); });
+            if (!address.has_value() || !size.has_value() || *size < 1 || *size > 16)
+                return std::nullopt;
+
+            std::optional<Token::Literal> endianParam;
+            if (params.size() == 3)
+                endianParam = evaluateConstant(evaluator, params[2].get());
+            else if (const auto &defaultParameters = customFunctions.at(name).defaultParameters; defaultParameters.size() == 1)
+                endianParam = defaultParameters.front();
+
+            // Only the std library function converts enum values to integers before passing them on
+            auto endian = endianParam.and_then([&](const auto &value) { return toEndian(value, name == StdName); });
+            if (!endian.has_value())
+                return std::nullopt;
+
+            return compileRead(window, *address, u8(*size), *endian);
+        }
+
+        [[nodiscard]] static std::optional<CompiledValue> compileValue(Evaluator *evaluator, const std::shared_ptr<DataWindow> &window, const ASTNode *node) {
+            if (isInvariant(node)) {
+                if (auto constant = evaluateConstant(evaluator, node); constant.has_value())
+                    return CompiledValue { nullptr, std::move(constant) };
+                return std::nullopt;
+            }
+
+            if (isOffset(node))
+                return CompiledValue { [](u64 offset) { return u128(offset); }, std::nullopt };
+
+            // $[address] reads a single byte
+            if (auto rvalue = dynamic_cast<const ASTNodeRValue *>(node); rvalue != nullptr && rvalue->getPath().size() == 2) {
+                const auto &path = rvalue->getPath();
+                auto name  = std::get_if<std::string>(&path[0]);
+                auto index = std::get_if<std::unique_ptr<ASTNode>>(&path[1]);
+                if (name == nullptr || *name != "$" || index == nullptr)
+                    return std::nullopt;
+
+                auto address = compileAddress(evaluator, index->get());
+                if (!address.has_value())
+                    return std::nullopt;
+
+                return compileRead(window, *address, 1, std::endian::native);
+            }
+
+            if (auto call = dynamic_cast<const ASTNodeFunctionCall *>(node); call != nullptr)
+                return compileReadUnsigned(evaluator, window, call);
+
+            return std::nullopt;
+        }
+
+        template<typename T>
+        [[nodiscard]] static std::optional<NativeCondition> compileComparison(Token::Operator op, std::function<T(u64)> left, std::function<T(u64)> right) {
+            switch (op) {
+                using enum Token::Operator;
+                case BoolEqual:              return [=](u64 offset) { return left(offset) == right(offset); };
+                case BoolNotEqual:           return [=](u64 offset) { return left(offset) != right(offset); };
+                case BoolGreaterThan:        return [=](u64 offset) { return left(offset) >  right(offset); };
+                case BoolLessThan:           return [=](u64 offset) { return left(offset) <  right(offset); };
+                case BoolGreaterThanOrEqual: return [=](u64 offset) { return left(offset) >= right(offset); };
+                case BoolLessThanOrEqual:    return [=](u64 offset) { return left(offset) <= right(offset); };
+                default:                     return std::nullopt;
+            }
+        }
+
+        // Comparisons convert the right operand to the type of the left one, patterns are compared by their unsigned value
+        [[nodiscard]] static std::optional<NativeCondition> compileComparison(Token::Operator op, const CompiledValue &left, const CompiledValue &right) {
+            if (left.constant.has_value() && right.constant.has_value())
+                return std::nullopt;
+
+            if (left.constant.has_value() && std::holds_alternative<i128>(*left.constant)) {
+                const auto constant = std::get<i128>(*left.constant);
+                return compileComparison<i128>(op, [constant](u64) { return constant; }, [compute = right.compute](u64 offset) { return i128(compute(offset)); });
+            }
+
+            auto toFunction = [](const CompiledValue &value) -> std::optional<std::function<u128(u64)>> {
+                if (!value.constant.has_value())
+                    return value.compute;
+
+                auto constant = toInteger(*value.constant, true);
+                if (!constant.has_value())
+                    return std::nullopt;
+
+                return [constant = *constant](u64) { return constant; };
+            };
+
+            auto leftFunction = toFunction(left), rightFunction = toFunction(right);
+            if (!leftFunction.has_value() || !rightFunction.has_value())
+                return std::nullopt;
+
+            return compileComparison<u128>(op, std::move(*leftFunction), std::move(*rightFunction));
+        }
+
+        [[nodiscard]] static std::optional<NativeCondition> compilePredicate(Evaluator *evaluator, const std::shared_ptr<DataWindow> &window, const ASTNode *node) {
+            if (auto expression = dynamic_cast<const ASTNodeMathematicalExpression *>(node); expression != nullptr && !isInvariant(node)) {
+                const auto left = expression->getLeftOperand().get(), right = expression->getRightOperand().get();
+                if (left == nullptr || right == nullptr)
+                    return std::nullopt;
+
+                switch (const auto op = expression->getOperator()) {
+                    using enum Token::Operator;
+                    case BoolAnd:
+                    case BoolOr:
+                    case BoolXor: {
+                        auto leftPredicate  = compilePredicate(evaluator, window, left);
+                        auto rightPredicate = compilePredicate(evaluator, window, right);
+                        if (!leftPredicate.has_value() || !rightPredicate.has_value())
+                            return std::nullopt;
+
+                        if (op == BoolAnd)
+                            return [l = std::move(*leftPredicate), r = std::move(*rightPredicate)](u64 offset) { return l(offset) && r(offset); };
+                        else if (op == BoolOr)
+                            return [l = std::move(*leftPredicate), r = std::move(*rightPredicate)](u64 offset) { return l(offset) || r(offset); };
+                        else
+                            return [l = std::move(*leftPredicate), r = std::move(*rightPredicate)](u64 offset) { return l(offset) != r(offset); };
+                    }
+                    case BoolNot: {
+                        auto predicate = compilePredicate(evaluator, window, right);
+                        if (!predicate.has_value())
+                            return std::nullopt;
+
+                        return [p = std::move(*predicate)](u64 offset) { return !p(offset); };
+                    }
+                    case BoolEqual:
+                    case BoolNotEqual:
+                    case BoolGreaterThan:
+                    case BoolLessThan:
+                    case BoolGreaterThanOrEqual:
+                    case BoolLessThanOrEqual: {
+                        auto leftValue  = compileValue(evaluator, window, left);
+                        auto rightValue = compileValue(evaluator, window, right);
+                        if (!leftValue.has_value() || !rightValue.has_value())
+                            return std::nullopt;
+
+                        return compileComparison(op, *leftValue, *rightValue);
+                    }
+                    default:
+                        break;
+                }
+            }
+
+            // Any other value is true if it's not zero
+            auto value = compileValue(evaluator, window, node);
+            if (!value.has_value())
+                return std::nullopt;
+
+            if (value->constant.has_value()) {
+                auto result = std::visit(wolv::util::overloaded {
+                    [](const std::string &) -> std::optional<bool> { return std::nullopt; },
+                    [](const std::shared_ptr<ptrn::Pattern> &) -> std::optional<bool> { return std::nullopt; },
+                    [](double) -> std::optional<bool> { return std::nullopt; },
+                    [](const auto &literal) -> std::optional<bool> { return literal != 0; }
+                }, *value->constant);
+
+                if (!result.has_value())
+                    return std::nullopt;
+
+                return [result = *result](u64) { return result; };
+            }
+
+            return [compute = std::move(value->compute)](u64 offset) { return compute(offset) != 0; };
+        }
+
     private:
         std::unique_ptr<ASTNode> m_condition;
         std::vector<std::unique_ptr<ASTNode>> m_body;
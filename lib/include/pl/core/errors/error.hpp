@@ -1,8 +1,12 @@
 #pragma once
 
+#include <concepts>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <pl/helpers/utils.hpp>
@@ -40,18 +44,58 @@ namespace pl::core::err {
     template<>
     class UserData<void> { };
 
+    // Error text that's only turned into a string once it's displayed. Errors thrown inside of try blocks
+    // are usually discarded again so this avoids formatting messages nobody ever reads.
+    // Only compile time constant strings are referenced directly, everything else is copied. Generators get
+    // invoked lazily and run after the stack has been unwound so they need to capture everything they use by value.
+    // They're invoked again every time the text is requested. Constructing a generator may still allocate if its
+    // captures don't fit into the std::function.
+    class ErrorText {
+    public:
+        ErrorText() = default;
+        consteval ErrorText(const char *text) : m_text(std::string_view(text)) { }
+        ErrorText(std::string text) : m_text(std::move(text)) { }
+
+        template<std::invocable F> requires std::convertible_to<std::invoke_result_t<F>, std::string>
+        ErrorText(F &&generator) : m_text(std::function<std::string()>(std::forward<F>(generator))) { }
+
+        [[nodiscard]] std::string get() const {
+            return std::visit(wolv::util::overloaded {
+                [](std::string_view text) { return std::string(text); },
+                [](const std::string &text) { return text; },
+                [](const std::function<std::string()> &generator) { return generator(); }
+            }, this->m_text);
+        }
+
+        [[nodiscard]] bool empty() const {
+            if (auto view = std::get_if<std::string_view>(&this->m_text))
+                return view->empty();
+            else if (auto text = std::get_if<std::string>(&this->m_text))
+                return text->empty();
+            else
+                return this->get().empty();
+        }
+
+    private:
+        std::variant<std::string_view, std::string, std::function<std::string()>> m_text;
+    };
+
     template<typename T = void>
     class Error {
     public:
         class Exception : public std::exception, public UserData<T> {
         public:
-            Exception(char prefix, u32 errorCode, std::string title, std::string description, std::string hint, UserData<T> userData = {}) :
+            Exception(char prefix, u32 errorCode, std::string title, ErrorText description, ErrorText hint, UserData<T> userData = {}) :
                     UserData<T>(userData), m_prefix(prefix), m_errorCode(errorCode), m_title(std::move(title)), m_description(std::move(description)), m_hint(std::move(hint)) {
-                this->m_shortMessage = fmt::format("error[{}{:04}]: {}\n{}", this->m_prefix, this->m_errorCode, this->m_title, this->m_description).c_str();
             }
 
+            // Only the title is available without formatting the rest of the message, use getShortMessage() to display the error
             [[nodiscard]] const char *what() const noexcept override {
-                return this->m_shortMessage.c_str();
+                return this->m_title.c_str();
+            }
+
+            [[nodiscard]] std::string getShortMessage() const {
+                return fmt::format("error[{}{:04}]: {}\n{}", this->m_prefix, this->m_errorCode, this->m_title, this->m_description.get());
             }
 
             [[nodiscard]] std::string format(const std::string &sourceCode, u32 line, u32 column) const {
@@ -72,15 +116,15 @@ namespace pl::core::err {
                         {
                             const auto descriptionSpacing = std::string(lineNumberPrefix.length() + column - 1, ' ');
                             errorMessage += descriptionSpacing + "^\n";
-                            errorMessage += descriptionSpacing + this->m_description + "\n\n";
+                            errorMessage += descriptionSpacing + this->m_description.get() + "\n\n";
                         }
                     }
                 } else {
-                    errorMessage += this->m_description + "\n";
+                    errorMessage += this->m_description.get() + "\n";
                 }
 
                 if (!this->m_hint.empty()) {
-                    errorMessage += fmt::format("hint: {}", this->m_hint);
+                    errorMessage += fmt::format("hint: {}", this->m_hint.get());
                 }
 
                 return errorMessage;
@@ -89,20 +133,20 @@ namespace pl::core::err {
         private:
             char m_prefix;
             u32 m_errorCode;
-            std::string m_shortMessage;
-            std::string m_title, m_description, m_hint;
+            std::string m_title;
+            ErrorText m_description, m_hint;
         };
 
         Error(char prefix, u32 errorCode, std::string title) : m_prefix(prefix), m_errorCode(errorCode), m_title(std::move(title)) {
 
         }
 
-        [[nodiscard]] std::string format(const std::string &description, const std::string &hint = { }, UserData<T> userData = { }) const {
-            return Exception(this->m_prefix, this->m_errorCode, this->m_title, description, hint, userData).what();
+        [[nodiscard]] std::string format(ErrorText description, ErrorText hint = { }, UserData<T> userData = { }) const {
+            return Exception(this->m_prefix, this->m_errorCode, this->m_title, std::move(description), std::move(hint), userData).getShortMessage();
         }
 
-        [[noreturn]] void throwError(const std::string &description, const std::string &hint = { }, UserData<T> userData = { }) const {
-            throw Exception(this->m_prefix, this->m_errorCode, this->m_title, description, hint, userData);
+        [[noreturn]] void throwError(ErrorText description, ErrorText hint = { }, UserData<T> userData = { }) const {
+            throw Exception(this->m_prefix, this->m_errorCode, this->m_title, std::move(description), std::move(hint), userData);
         }
 
     private:
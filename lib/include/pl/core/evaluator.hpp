@@ -3,14 +3,20 @@
 #include <atomic>
 #include <bit>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <unordered_set>
 #include <unordered_map>
 
 #include <pl/core/log_console.hpp>
+#include <pl/core/memory_profiler.hpp>
+#include <pl/core/statistics.hpp>
+#include <pl/core/tracer.hpp>
 #include <pl/core/token.hpp>
+#include <pl/helpers/format_string.hpp>
 #include <pl/api.hpp>
 
 #include <fmt/format.h>
@@ -28,6 +34,7 @@ namespace pl::core {
     namespace ast {
         class ASTNode;
         class ASTNodeBitfieldField;
+        class ASTNodeFunctionDefinition;
     }
 
     enum class DangerousFunctionPermission {
@@ -62,6 +69,30 @@ namespace pl::core {
             return this->m_console;
         }
 
+        [[nodiscard]] Statistics &getStatistics() {
+            return this->m_statistics;
+        }
+
+        [[nodiscard]] const Statistics &getStatistics() const {
+            return this->m_statistics;
+        }
+
+        [[nodiscard]] hlp::FormatStringCache &getFormatStringCache() {
+            return this->m_formatStringCache;
+        }
+
+        [[nodiscard]] Tracer &getTracer() {
+            return this->m_tracer;
+        }
+
+        [[nodiscard]] MemoryProfiler &getMemoryProfiler() {
+            return this->m_memoryProfiler;
+        }
+
+        [[nodiscard]] const MemoryProfiler &getMemoryProfiler() const {
+            return this->m_memoryProfiler;
+        }
+
         struct ParameterPack {
             std::string name;
             std::vector<Token::Literal> values;
@@ -162,6 +193,12 @@ namespace pl::core {
         }
 
         void accessData(u64 address, void *buffer, size_t size, u64 sectionId, bool write);
+
+        // Incremented on every write so copies of the data can tell if they're outdated
+        [[nodiscard]] u64 getDataWriteCount() const {
+            return this->m_dataWriteCount;
+        }
+
         void readData(u64 address, void *buffer, size_t size, u64 sectionId) {
             this->accessData(address, buffer, size, sectionId, false);
         }
@@ -174,6 +211,12 @@ namespace pl::core {
         }
 
         [[nodiscard]] std::endian getDefaultEndian() const {
+            // Functions called while formatting temporarily change the default endianness
+            if (this->m_concurrentAccess) [[unlikely]] {
+                auto lock = this->lockSharedState();
+                return this->m_defaultEndian;
+            }
+
             return this->m_defaultEndian;
         }
 
@@ -278,10 +321,18 @@ namespace pl::core {
 
         [[nodiscard]] u128 readBits(u128 byteOffset, u8 bitOffset, u64 bitSize, u64 section, std::endian endianness) {
             u128 value = 0;
+            this->readData(byteOffset, &value, getBitsReadSize(bitOffset, bitSize), section);
 
-            size_t readSize = (bitOffset + bitSize + 7) / 8;
-            readSize = std::min(readSize, sizeof(value));
-            this->readData(byteOffset, &value, readSize, section);
+            return extractBits(value, bitOffset, bitSize, endianness);
+        }
+
+        // Number of bytes readBits() reads for the given bits
+        [[nodiscard]] constexpr static size_t getBitsReadSize(u8 bitOffset, u64 bitSize) {
+            return std::min<size_t>((bitOffset + bitSize + 7) / 8, sizeof(u128));
+        }
+
+        // Extracts the bits from bytes that were copied into value the same way readBits() reads them
+        [[nodiscard]] constexpr static u128 extractBits(u128 value, u8 bitOffset, u64 bitSize, std::endian endianness) {
             value = hlp::changeEndianess(value, sizeof(value), endianness);
 
             size_t offset = endianness == std::endian::little ? bitOffset : (sizeof(value) * 8) - bitOffset - bitSize;
@@ -312,20 +363,38 @@ namespace pl::core {
 
         bool addBuiltinFunction(const std::string &name, api::FunctionParameterCount numParams, std::vector<Token::Literal> defaultParameters, const api::FunctionCallback &function, bool dangerous) {
             const auto [iter, inserted] = this->m_builtinFunctions.insert({
-                name, {numParams, std::move(defaultParameters), function, dangerous}
+                name, {numParams, std::move(defaultParameters), [function](Evaluator *ctx, const std::vector<Token::Literal> &params) {
+                    ctx->m_statistics.builtinFunctionCalls++;
+                    return function(ctx, params);
+                }, dangerous, true}
             });
 
             return inserted;
         }
 
-        bool addCustomFunction(const std::string &name, api::FunctionParameterCount numParams, std::vector<Token::Literal> defaultParameters, const api::FunctionCallback &function) {
+        bool addCustomFunction(const std::string &name, api::FunctionParameterCount numParams, std::vector<Token::Literal> defaultParameters, const api::FunctionCallback &function, bool retainsParameters = true) {
             const auto [iter, inserted] = this->m_customFunctions.insert({
-                name, {numParams, std::move(defaultParameters), function, false}
+                name, {numParams, std::move(defaultParameters), [function](Evaluator *ctx, const std::vector<Token::Literal> &params) {
+                    ctx->m_statistics.customFunctionCalls++;
+                    return function(ctx, params);
+                }, false, retainsParameters}
             });
 
             return inserted;
         }
 
+        // Definitions of the functions added by the pattern so their bodies can be inspected. The first definition of a name wins, like in addCustomFunction
+        void addCustomFunctionDefinition(const std::string &name, const ast::ASTNodeFunctionDefinition *definition) {
+            this->m_customFunctionNodes.emplace(name, definition);
+        }
+
+        [[nodiscard]] const ast::ASTNodeFunctionDefinition *getCustomFunctionDefinition(const std::string &name) const {
+            if (auto it = this->m_customFunctionNodes.find(name); it != this->m_customFunctionNodes.end())
+                return it->second;
+            else
+                return nullptr;
+        }
+
         [[nodiscard]] const std::unordered_map<std::string, api::Function> &getBuiltinFunctions() const {
             return this->m_builtinFunctions;
         }
@@ -369,7 +438,7 @@ namespace pl::core {
         }
 
         void handleAbort() {
-            if (this->m_aborted)
+            if (this->m_aborted.load(std::memory_order_relaxed)) [[unlikely]]
                 err::E0007.throwError("Evaluation aborted by user.");
         }
 
@@ -417,9 +486,25 @@ namespace pl::core {
             return this->m_mainResult;
         }
 
-        void setCurrentArrayIndex(u64 index) { this->m_currArrayIndex = index; }
-        void clearCurrentArrayIndex() { this->m_currArrayIndex = std::nullopt; }
-        [[nodiscard]] std::optional<u64> getCurrentArrayIndex() const { return this->m_currArrayIndex; }
+        void setCurrentArrayIndex(u64 index) { this->getCurrentArrayIndexStorage() = index; }
+        void clearCurrentArrayIndex() { this->getCurrentArrayIndexStorage() = std::nullopt; }
+        [[nodiscard]] std::optional<u64> getCurrentArrayIndex() const { return this->m_concurrentAccess ? this->getThreadArrayIndex() : this->m_currArrayIndex; }
+
+        // Allows patterns to be read from multiple threads at once after evaluation finished, e.g. by formatters.
+        // Everything touching shared evaluator state then needs to hold the lock returned by lockSharedState().
+        // Reads from the main section skip it, the data source has to support being read from multiple threads
+        void setConcurrentAccess(bool enabled);
+
+        [[nodiscard]] bool isConcurrentAccessEnabled() const {
+            return this->m_concurrentAccess;
+        }
+
+        [[nodiscard]] std::unique_lock<std::recursive_mutex> lockSharedState() const {
+            if (this->m_concurrentAccess) [[unlikely]]
+                return std::unique_lock(this->m_sharedStateMutex);
+            else
+                return { };
+        }
 
         void setDebugMode(bool enabled) {
             this->m_debugMode = enabled;
@@ -434,7 +519,18 @@ namespace pl::core {
             return this->m_debugMode;
         }
 
-        void updateRuntime(const ast::ASTNode *node);
+        void updateRuntime(const ast::ASTNode *node) {
+            // The abort flag is only polled every few nodes here, loops poll it on every iteration themselves
+            if (--this->m_abortPollCountdown == 0) [[unlikely]] {
+                this->m_abortPollCountdown = AbortPollInterval;
+
+                if (!this->m_evaluated)
+                    this->handleAbort();
+            }
+
+            if (this->m_hasBreakpoints) [[unlikely]]
+                this->handleBreakpoints(node);
+        }
 
         void addBreakpoint(u64 line);
         void removeBreakpoint(u64 line);
@@ -444,6 +540,18 @@ namespace pl::core {
         std::optional<u32> getPauseLine() const;
 
     private:
+        void handleBreakpoints(const ast::ASTNode *node);
+
+        std::optional<u64> &getCurrentArrayIndexStorage() {
+            if (this->m_concurrentAccess) [[unlikely]]
+                return this->getThreadArrayIndex();
+            else
+                return this->m_currArrayIndex;
+        }
+
+        // Each thread iterates its own arrays while concurrent access is enabled
+        std::optional<u64> &getThreadArrayIndex() const;
+
         void patternCreated(ptrn::Pattern *pattern);
         void patternDestroyed(ptrn::Pattern *pattern);
 
@@ -455,6 +563,10 @@ namespace pl::core {
         bool m_evaluated = false;
         bool m_debugMode = false;
         LogConsole m_console;
+        Statistics m_statistics;
+        Tracer m_tracer;
+        MemoryProfiler m_memoryProfiler;
+        hlp::FormatStringCache m_formatStringCache;
 
         u32 m_colorIndex = 0;
 
@@ -476,6 +588,7 @@ namespace pl::core {
         std::unordered_map <std::string, api::Function> m_customFunctions;
         std::unordered_map <std::string, api::Function> m_builtinFunctions;
         std::vector<std::unique_ptr<ast::ASTNode>> m_customFunctionDefinitions;
+        std::unordered_map<std::string, const ast::ASTNodeFunctionDefinition *> m_customFunctionNodes;
 
         std::optional<Token::Literal> m_mainResult;
 
@@ -496,6 +609,7 @@ namespace pl::core {
 
         u64 m_dataBaseAddress = 0x00;
         u64 m_dataSize = 0x00;
+        u64 m_dataWriteCount = 0;
         std::function<void(u64, u8*, size_t)> m_readerFunction = [](u64, u8*, size_t){
             err::E0011.throwError("No memory has been attached. Reading is disabled.");
         };
@@ -505,7 +619,18 @@ namespace pl::core {
 
         std::optional<u64> m_currArrayIndex;
 
+        std::atomic<bool> m_concurrentAccess = false;
+        mutable std::recursive_mutex m_sharedStateMutex;
+        u64 m_concurrentAccessSession = 0;
+        mutable std::map<std::thread::id, std::optional<u64>> m_threadArrayIndices;
+        mutable std::mutex m_threadArrayIndicesMutex;
+
+        constexpr static u32 AbortPollInterval = 64;
+        u32 m_abortPollCountdown = AbortPollInterval;
+
         std::unordered_set<int> m_breakpoints;
+        std::vector<u64> m_breakpointBitmap;
+        bool m_hasBreakpoints = false;
         std::optional<u32> m_lastPauseLine;
 
         u32 getNextPatternColor() {
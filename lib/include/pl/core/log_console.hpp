@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <memory>
@@ -23,11 +29,33 @@ namespace pl::core {
             Error       = 3
         };
 
+        struct Entry {
+            Level level;
+            std::string message;
+        };
+
         using Callback = std::function<void(Level level, const std::string&)>;
+        using BatchCallback = std::function<void(const std::vector<Entry>&)>;
+
+        LogConsole() = default;
+        LogConsole(const LogConsole &) = delete;
+        LogConsole(LogConsole &&) = delete;
+
+        ~LogConsole() {
+            this->disableBuffering();
+        }
 
         void log(Level level, const std::string &message) const {
-            if (u8(level) >= u8(this->m_logLevel) && this->m_logCallback)
-                this->m_logCallback(level, message);
+            if (u8(level) < u8(this->m_logLevel))
+                return;
+
+            if (!this->m_buffered && !this->m_rateLimited) [[likely]] {
+                if (this->m_logCallback)
+                    this->m_logCallback(level, message);
+                return;
+            }
+
+            this->logSlow(level, message);
         }
 
         void clear() {
@@ -43,14 +71,61 @@ namespace pl::core {
         }
 
         void setLogCallback(const Callback &callback) {
+            std::scoped_lock lock(this->m_deliveryMutex);
             this->m_logCallback = callback;
         }
 
+        // When set, buffered messages are handed to the host in batches instead of line by line
+        void setLogBatchCallback(const BatchCallback &callback) {
+            std::scoped_lock lock(this->m_deliveryMutex);
+            this->m_logBatchCallback = callback;
+        }
+
+        // Messages get collected in a ring buffer of the given capacity and are delivered once it fills up, when flush() is called
+        // or, if a background thread is used, periodically from that thread. Callbacks need to be thread-safe in that case
+        void enableBuffering(size_t capacity, bool backgroundThread);
+        void disableBuffering();
+
+        [[nodiscard]] bool isBufferingEnabled() const {
+            return this->m_buffered;
+        }
+
+        // Messages above the limit within one second are dropped and reported as a single summary line. A limit of 0 disables limiting
+        void setRateLimit(Level level, u64 messagesPerSecond);
+
+        void flush() const;
+
     private:
+        void logSlow(Level level, const std::string &message) const;
+        void push(Level level, std::string message) const;
+        void backgroundThread(std::stop_token stopToken);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct RateLimit {
+            u64 messagesPerSecond = 0;
+            Clock::time_point windowStart;
+            u64 messagesInWindow = 0;
+            u64 suppressed = 0;
+        };
+
         Level m_logLevel = Level::Info;
 
         Callback m_logCallback;
+        BatchCallback m_logBatchCallback;
         std::optional<err::PatternLanguageError> m_lastHardError;
+
+        bool m_buffered = false;
+        bool m_rateLimited = false;
+
+        mutable std::mutex m_bufferMutex, m_deliveryMutex;
+        mutable std::vector<Entry> m_buffer;
+        mutable size_t m_bufferStart = 0, m_bufferCount = 0;
+        mutable std::array<RateLimit, 4> m_rateLimits;
+
+        mutable std::condition_variable_any m_bufferFilled;
+        std::jthread m_backgroundThread;
     };
 
-}
\ No newline at end of file
+}
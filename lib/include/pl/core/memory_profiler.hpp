@@ -0,0 +1,109 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pl/api.hpp>
+#include <pl/helpers/types.hpp>
+
+namespace pl::ptrn { class Pattern; }
+
+namespace pl::core {
+
+    /*
+     * Attributes the patterns, heap cells and sections created during an evaluation to the top-level declarations that created them.
+     * Patterns are still being filled in while they're created, so their size is only measured once the declaration that created
+     * them has been evaluated, when the consumers are queried or right before they're destroyed. If a declaration fails, everything
+     * that's still alive is measured while the error unwinds so the partially created patterns are part of the high-water mark.
+     */
+    class MemoryProfiler {
+    public:
+        struct Usage {
+            u64 patternCount = 0, patternBytes = 0;
+            u64 heapCellCount = 0, heapBytes = 0;
+            u64 sectionCount = 0, sectionBytes = 0;
+
+            [[nodiscard]] u64 getTotalCount() const { return this->patternCount + this->heapCellCount + this->sectionCount; }
+            [[nodiscard]] u64 getTotalBytes() const { return this->patternBytes + this->heapBytes + this->sectionBytes; }
+        };
+
+        struct Consumer {
+            std::string typeName;
+            u32 line;
+            Usage usage;
+        };
+
+        MemoryProfiler() {
+            this->reset();
+        }
+
+        void setEnabled(bool enabled) {
+            this->m_enabled = enabled;
+        }
+
+        [[nodiscard]] bool isEnabled() const {
+            return this->m_enabled;
+        }
+
+        void reset();
+
+        // Allocations are attributed to the innermost site on the stack
+        void pushSite(const std::string &typeName, u32 line);
+        void popSite();
+
+        void patternCreated(const ptrn::Pattern *pattern);
+        // Called before a pattern's members are destroyed so it can still be measured in full
+        void patternDestroying(const ptrn::Pattern *pattern);
+        void patternDestroyed(const ptrn::Pattern *pattern);
+
+        // Measures the size of all patterns that were created since the last call
+        void measurePatterns(bool forceSnapshot = false);
+
+        void heapCellCreated(u64 index, u64 bytes);
+        void heapCellResized(u64 index, u64 bytes);
+        void heapCellsDestroyed(u64 startIndex);
+
+        void sectionCreated(u64 id);
+        void sectionRemoved(u64 id);
+
+        // Sections aren't part of the high-water mark snapshot as their content is only sized at report time
+        [[nodiscard]] std::vector<Consumer> getConsumers(const std::map<u64, api::Section> &sections, bool atHighWaterMark = false) const;
+
+        [[nodiscard]] u64 getHighWaterMark() const {
+            return this->m_highWaterMark;
+        }
+
+    private:
+        u32 getCurrentSite() const;
+        void updateHighWaterMark(bool forceSnapshot = false);
+
+    private:
+        bool m_enabled = false;
+
+        std::vector<std::pair<std::string, u32>> m_sites;
+        std::map<std::pair<std::string, u32>, u32> m_siteIndices;
+        std::vector<u32> m_siteStack;
+
+        std::vector<Usage> m_usages;
+        std::vector<Usage> m_highWaterMarkUsages;
+
+        struct PatternEntry {
+            u32 site;
+            u64 bytes;
+            bool measured;
+        };
+
+        std::unordered_map<const ptrn::Pattern*, PatternEntry> m_patterns;
+        std::vector<const ptrn::Pattern*> m_unmeasuredPatterns;
+        std::vector<std::pair<u32, u64>> m_heapCells;
+        std::map<u64, u32> m_sections;
+
+        u64 m_liveBytes = 0;
+        u64 m_highWaterMark = 0;
+        u64 m_snapshotBytes = 0;
+    };
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include <pl/helpers/types.hpp>
+
+namespace pl::core {
+
+    struct Statistics {
+        using Duration = std::chrono::duration<double>;
+
+        struct PhaseTimings {
+            Duration preprocess = Duration::zero();
+            Duration lex        = Duration::zero();
+            Duration parse      = Duration::zero();
+            Duration validate   = Duration::zero();
+            Duration evaluate   = Duration::zero();
+            Duration flatten    = Duration::zero();
+        };
+
+        struct DataAccess {
+            u64 readCalls = 0, readBytes = 0;
+            u64 writeCalls = 0, writeBytes = 0;
+
+            void record(size_t size, bool write) {
+                if (write) {
+                    this->writeCalls += 1;
+                    this->writeBytes += size;
+                } else {
+                    this->readCalls += 1;
+                    this->readBytes += size;
+                }
+            }
+        };
+
+        PhaseTimings timings;
+
+        DataAccess mainSection;
+        DataAccess heapSection;
+        DataAccess patternLocalSection;
+        std::vector<DataAccess> customSections;     // Indexed by the section id
+
+        u64 heapCellHighWaterMark = 0;
+        u64 patternLocalSlotHighWaterMark = 0;
+
+        u64 patternsCreated = 0;
+        u64 patternsDestroyed = 0;
+        u64 patternClones = 0;
+
+        u64 builtinFunctionCalls = 0;
+        u64 customFunctionCalls = 0;
+
+        u64 evaluationErrors = 0;                   // Errors caught by try statements or reported at the end of the evaluation
+    };
+
+}
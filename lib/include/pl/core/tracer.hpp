@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pl/helpers/types.hpp>
+
+namespace pl::core {
+
+    class Tracer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Event {
+            std::string name;
+            std::string_view category;
+            Clock::time_point start;
+            Clock::duration duration;
+            u32 threadId;
+        };
+
+        class Span {
+        public:
+            Span() = default;
+            Span(Tracer *tracer, std::string_view category, std::string name)
+                : m_tracer(tracer), m_category(category), m_name(std::move(name)), m_start(Clock::now()) { }
+
+            Span(const Span &) = delete;
+            Span(Span &&other) noexcept
+                : m_tracer(std::exchange(other.m_tracer, nullptr)), m_category(other.m_category), m_name(std::move(other.m_name)), m_start(other.m_start) { }
+
+            Span& operator=(const Span &) = delete;
+            Span& operator=(Span &&) = delete;
+
+            ~Span() {
+                this->end();
+            }
+
+            void end() {
+                if (this->m_tracer == nullptr)
+                    return;
+
+                this->m_tracer->addEvent(std::move(this->m_name), this->m_category, this->m_start, Clock::now());
+                this->m_tracer = nullptr;
+            }
+
+        private:
+            Tracer *m_tracer = nullptr;
+            std::string_view m_category;
+            std::string m_name;
+            Clock::time_point m_start;
+        };
+
+        Tracer() = default;
+        Tracer(const Tracer &) = delete;
+        Tracer(Tracer &&) = delete;
+
+        void setEnabled(bool enabled) {
+            this->m_enabled = enabled;
+        }
+
+        [[nodiscard]] bool isEnabled() const {
+            return this->m_enabled.load(std::memory_order_relaxed);
+        }
+
+        // Categories need to be string literals as they're stored as views
+        [[nodiscard]] Span beginSpan(std::string_view category, std::string_view name) {
+            if (!this->isEnabled()) [[likely]]
+                return { };
+
+            return { this, category, std::string(name) };
+        }
+
+        // The name generator is only invoked while tracing is enabled so span names cost nothing otherwise
+        template<std::invocable F>
+        [[nodiscard]] Span beginSpan(std::string_view category, F &&nameGenerator) {
+            if (!this->isEnabled()) [[likely]]
+                return { };
+
+            return { this, category, std::string(nameGenerator()) };
+        }
+
+        void clear();
+
+        [[nodiscard]] std::vector<Event> getEvents() const;
+        [[nodiscard]] std::string toJson() const;
+
+    private:
+        void addEvent(std::string name, std::string_view category, Clock::time_point start, Clock::time_point end);
+
+    private:
+        std::atomic<bool> m_enabled = false;
+
+        mutable std::mutex m_mutex;
+        Clock::time_point m_epoch = Clock::now();
+        std::vector<Event> m_events;
+        std::vector<std::thread::id> m_threadIds;
+    };
+
+}
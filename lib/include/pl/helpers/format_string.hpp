@@ -0,0 +1,154 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace pl::hlp {
+
+    /*
+     * fmt style format string that has been split up into literal text and replacement fields once
+     * so it can be applied to new arguments without scanning it again.
+     * Anything beyond plain positional fields (named arguments, nested width or precision fields and
+     * malformed strings) marks the format string as not simple. These need to go through fmt::vformat instead
+     * which also produces the matching error messages.
+     */
+    class FormatString {
+    public:
+        struct Field {
+            std::string prefix;
+            size_t argumentIndex;
+            std::string format;     // "{:spec}", empty if the field has no format spec
+        };
+
+        static FormatString parse(std::string_view format) {
+            FormatString result;
+
+            std::string literal;
+            size_t nextAutoIndex = 0;
+            bool autoIndexing = false, manualIndexing = false;
+
+            for (size_t i = 0; i < format.size(); i++) {
+                const char c = format[i];
+
+                if (c == '}') {
+                    if (i + 1 < format.size() && format[i + 1] == '}') {
+                        literal += '}';
+                        i++;
+                        continue;
+                    }
+
+                    return { };
+                } else if (c != '{') {
+                    literal += c;
+                    continue;
+                }
+
+                if (i + 1 < format.size() && format[i + 1] == '{') {
+                    literal += '{';
+                    i++;
+                    continue;
+                }
+
+                const auto end = format.find('}', i + 1);
+                if (end == std::string_view::npos)
+                    return { };
+
+                const auto field = format.substr(i + 1, end - i - 1);
+                const auto colon = field.find(':');
+                const auto id = field.substr(0, colon);
+                const auto spec = colon == std::string_view::npos ? std::string_view() : field.substr(colon + 1);
+
+                if (spec.contains('{'))
+                    return { };
+
+                size_t argumentIndex = 0;
+                if (id.empty()) {
+                    autoIndexing = true;
+                    argumentIndex = nextAutoIndex++;
+                } else {
+                    if ((id.size() > 1 && id[0] == '0') || !std::all_of(id.begin(), id.end(), [](char digit) { return digit >= '0' && digit <= '9'; }))
+                        return { };
+
+                    manualIndexing = true;
+                    argumentIndex = std::stoull(std::string(id));
+                }
+
+                if (autoIndexing && manualIndexing)
+                    return { };
+
+                result.m_fields.push_back({ std::move(literal), argumentIndex, spec.empty() ? "" : fmt::format("{{:{}}}", spec) });
+                literal.clear();
+
+                i = end;
+            }
+
+            result.m_suffix = std::move(literal);
+            result.m_simple = true;
+
+            return result;
+        }
+
+        [[nodiscard]] bool isSimple() const {
+            return this->m_simple;
+        }
+
+        [[nodiscard]] const std::vector<Field> &getFields() const {
+            return this->m_fields;
+        }
+
+        [[nodiscard]] const std::string &getSuffix() const {
+            return this->m_suffix;
+        }
+
+    private:
+        bool m_simple = false;
+        std::vector<Field> m_fields;
+        std::string m_suffix;
+    };
+
+    // Parsed format strings are looked up by their content. The output buffer is shared by nested
+    // formatting calls, each of them only owns what it appended after its own starting offset
+    class FormatStringCache {
+    public:
+        [[nodiscard]] std::shared_ptr<const FormatString> get(std::string_view format) {
+            if (auto it = this->m_formatStrings.find(format); it != this->m_formatStrings.end())
+                return it->second;
+
+            // Format strings built at runtime could make the cache grow forever, start over instead
+            if (this->m_formatStrings.size() >= MaxEntries)
+                this->m_formatStrings.clear();
+
+            auto formatString = std::make_shared<const FormatString>(FormatString::parse(format));
+            this->m_formatStrings.emplace(std::string(format), formatString);
+
+            return formatString;
+        }
+
+        [[nodiscard]] fmt::memory_buffer &getBuffer() {
+            return this->m_buffer;
+        }
+
+    private:
+        struct Hash {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view string) const {
+                return std::hash<std::string_view>{}(string);
+            }
+        };
+
+        constexpr static size_t MaxEntries = 1024;
+
+        std::unordered_map<std::string, std::shared_ptr<const FormatString>, Hash, std::equal_to<>> m_formatStrings;
+        fmt::memory_buffer m_buffer;
+    };
+
+}
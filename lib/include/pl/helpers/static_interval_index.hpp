@@ -0,0 +1,141 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace pl::hlp {
+
+    /*
+     * Immutable index of closed intervals that's built once from all of its elements.
+     * The intervals are stored sorted by their start address in one contiguous array which doubles as an implicit
+     * balanced search tree, the root of every range of nodes is the one in its middle. Each node also stores the largest
+     * end address of its subtree. Intervals starting inside a queried range form one run of the array that's reported
+     * with a linear scan, only the ones starting before it need the tree to skip every subtree that ends too early.
+     * Results are reported sorted by start address, intervals with the same start in the order they were added.
+     */
+    template<typename T>
+    class StaticIntervalIndex {
+    public:
+        struct Interval {
+            u64 start, end;
+        };
+
+        struct Element {
+            Interval interval;
+            T value;
+        };
+
+        StaticIntervalIndex() = default;
+
+        explicit StaticIntervalIndex(std::vector<Element> elements) {
+            std::stable_sort(elements.begin(), elements.end(), [](const Element &left, const Element &right) {
+                return left.interval.start < right.interval.start;
+            });
+
+            this->m_nodes.reserve(elements.size());
+            this->m_values.reserve(elements.size());
+            for (auto &element : elements) {
+                this->m_nodes.push_back({ element.interval.start, element.interval.end, 0 });
+                this->m_values.push_back(std::move(element.value));
+            }
+
+            this->updateMaxEnd(0, this->m_nodes.size());
+        }
+
+        [[nodiscard]] std::vector<Element> overlapping(Interval interval) const {
+            const auto [first, last] = this->findStarts(interval);
+
+            std::vector<Element> result;
+            result.reserve(last - first);
+            this->queryBefore(0, this->m_nodes.size(), first, interval.start, [&](const Interval &found, const T &value) {
+                result.push_back({ found, value });
+            });
+
+            for (size_t i = first; i < last; i++)
+                result.push_back({ { this->m_nodes[i].start, this->m_nodes[i].end }, this->m_values[i] });
+
+            return result;
+        }
+
+        template<typename Callback>
+        void forEachOverlapping(Interval interval, Callback &&callback) const {
+            const auto [first, last] = this->findStarts(interval);
+
+            this->queryBefore(0, this->m_nodes.size(), first, interval.start, callback);
+
+            for (size_t i = first; i < last; i++)
+                callback(Interval { this->m_nodes[i].start, this->m_nodes[i].end }, this->m_values[i]);
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->size() == 0;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return this->m_nodes.size();
+        }
+
+        [[nodiscard]] size_t getMemoryUsage() const {
+            return this->m_nodes.capacity() * sizeof(Node) + this->m_values.capacity() * sizeof(T);
+        }
+
+    private:
+        struct Node {
+            u64 start, end;
+            u64 maxEnd;
+        };
+
+        // The run of nodes that start inside of the interval
+        [[nodiscard]] std::pair<size_t, size_t> findStarts(const Interval &interval) const {
+            const auto first = std::partition_point(this->m_nodes.begin(), this->m_nodes.end(), [&](const Node &node) {
+                return node.start < interval.start;
+            });
+            const auto last = std::partition_point(first, this->m_nodes.end(), [&](const Node &node) {
+                return node.start <= interval.end;
+            });
+
+            return { size_t(first - this->m_nodes.begin()), size_t(last - this->m_nodes.begin()) };
+        }
+
+        u64 updateMaxEnd(size_t begin, size_t end) {
+            if (begin >= end)
+                return 0;
+
+            const auto middle = begin + (end - begin) / 2;
+            auto &node = this->m_nodes[middle];
+            node.maxEnd = std::max({ node.end, this->updateMaxEnd(begin, middle), this->updateMaxEnd(middle + 1, end) });
+
+            return node.maxEnd;
+        }
+
+        // Reports the intervals in front of limit that still reach address
+        template<typename Callback>
+        void queryBefore(size_t begin, size_t end, size_t limit, u64 address, Callback &&callback) const {
+            if (begin >= end || begin >= limit)
+                return;
+
+            const auto middle = begin + (end - begin) / 2;
+            const auto &node = this->m_nodes[middle];
+            if (node.maxEnd < address)
+                return;
+
+            this->queryBefore(begin, middle, limit, address, callback);
+
+            if (middle >= limit)
+                return;
+
+            if (node.end >= address)
+                callback(Interval { node.start, node.end }, this->m_values[middle]);
+
+            this->queryBefore(middle + 1, end, limit, address, callback);
+        }
+
+    private:
+        std::vector<Node> m_nodes;
+        std::vector<T> m_values;
+    };
+
+}
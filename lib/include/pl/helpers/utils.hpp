@@ -4,6 +4,7 @@
 #include <bit>
 #include <cstring>
 #include <cctype>
+#include <concepts>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -109,6 +110,19 @@ namespace pl::hlp {
 
     [[nodiscard]] float float16ToFloat32(u16 float16);
 
+    // Index of the first of count entries of the given size whose bytes are all zero
+    [[nodiscard]] std::optional<size_t> findZeroEntry(const u8 *data, size_t count, size_t size);
+
+    // Converts many half precision values at once, using the F16C instructions if they're available
+    void float16ToFloat32(const u16 *float16, float *result, size_t count);
+
+    // Swaps the byte order of all values in the buffer. Written as a plain loop so compilers can vectorize it
+    template<std::unsigned_integral T> requires (sizeof(T) <= sizeof(u64))
+    void swapByteOrder(T *values, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            values[i] = std::byteswap(values[i]);
+    }
+
     [[nodiscard]] inline bool containsIgnoreCase(const std::string &a, const std::string &b) {
         auto iter = std::search(a.begin(), a.end(), b.begin(), b.end(), [](char ch1, char ch2) {
             return std::toupper(ch1) == std::toupper(ch2);
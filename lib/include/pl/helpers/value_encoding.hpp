@@ -0,0 +1,155 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+#include <pl/helpers/utils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <span>
+
+namespace pl::hlp {
+
+    /*
+     * Describes how a plain value is stored in the data, so many of them can be decoded at once without going
+     * through a pattern and a literal for every single value.
+     */
+    struct ValueEncoding {
+        enum class Type : u8 {
+            Unsigned,
+            Signed,
+            Float,
+            Boolean,
+            Character
+        };
+
+        Type type;
+        u8 size;
+        std::endian endian;
+
+        [[nodiscard]] bool operator==(const ValueEncoding &other) const = default;
+
+        // Whether decodeValues() supports this encoding
+        [[nodiscard]] bool isDecodable() const {
+            switch (this->type) {
+                case Type::Unsigned:
+                case Type::Signed:
+                    return this->size > 0 && this->size <= sizeof(u64);
+                case Type::Float:
+                    return this->size == sizeof(u16) || this->size == sizeof(float) || this->size == sizeof(double);
+                case Type::Boolean:
+                case Type::Character:
+                    return this->size == 1;
+            }
+
+            return false;
+        }
+    };
+
+    namespace impl {
+
+        // Values are copied into a small buffer of their storage type first, byte swapped in one go and then converted
+        template<typename Storage, typename T, typename Convert>
+        void decodeChunked(const u8 *data, std::span<T> result, std::endian endian, Convert &&convert) {
+            constexpr static size_t ChunkSize = 256;
+            std::array<Storage, ChunkSize> chunk;
+
+            for (size_t start = 0; start < result.size(); start += ChunkSize) {
+                const auto count = std::min(ChunkSize, result.size() - start);
+                std::memcpy(chunk.data(), data + start * sizeof(Storage), count * sizeof(Storage));
+
+                if (sizeof(Storage) > 1 && endian != std::endian::native)
+                    swapByteOrder(chunk.data(), count);
+
+                convert(std::span(chunk.data(), count), result.subspan(start, count));
+            }
+        }
+
+        template<typename T>
+        void decodeInteger(const ValueEncoding &encoding, const u8 *data, std::span<T> result) {
+            auto convert = [&](auto values, std::span<T> output) {
+                const auto bits = encoding.size * 8;
+                for (size_t i = 0; i < values.size(); i++) {
+                    if (encoding.type == ValueEncoding::Type::Signed && bits < 64)
+                        output[i] = static_cast<T>(i64(u64(values[i]) << (64 - bits)) >> (64 - bits));
+                    else if (encoding.type == ValueEncoding::Type::Signed)
+                        output[i] = static_cast<T>(i64(values[i]));
+                    else
+                        output[i] = static_cast<T>(values[i]);
+                }
+            };
+
+            switch (encoding.size) {
+                case 1: decodeChunked<u8>(data, result, encoding.endian, convert);  return;
+                case 2: decodeChunked<u16>(data, result, encoding.endian, convert); return;
+                case 4: decodeChunked<u32>(data, result, encoding.endian, convert); return;
+                case 8: decodeChunked<u64>(data, result, encoding.endian, convert); return;
+                default: break;
+            }
+
+            // Odd sizes like u24 or u48
+            for (size_t i = 0; i < result.size(); i++) {
+                u64 value = 0;
+                std::memcpy(&value, data + i * encoding.size, encoding.size);
+                value = changeEndianess(value, encoding.size, encoding.endian);
+
+                convert(std::span(&value, 1), result.subspan(i, 1));
+            }
+        }
+
+        template<typename T>
+        void decodeFloat(const ValueEncoding &encoding, const u8 *data, std::span<T> result) {
+            switch (encoding.size) {
+                case sizeof(u16):
+                    decodeChunked<u16>(data, result, encoding.endian, [](auto values, std::span<T> output) {
+                        std::array<float, 256> floats;
+                        float16ToFloat32(values.data(), floats.data(), values.size());
+
+                        for (size_t i = 0; i < values.size(); i++)
+                            output[i] = static_cast<T>(floats[i]);
+                    });
+                    return;
+                case sizeof(float):
+                    decodeChunked<u32>(data, result, encoding.endian, [](auto values, std::span<T> output) {
+                        for (size_t i = 0; i < values.size(); i++)
+                            output[i] = static_cast<T>(std::bit_cast<float>(values[i]));
+                    });
+                    return;
+                case sizeof(double):
+                    decodeChunked<u64>(data, result, encoding.endian, [](auto values, std::span<T> output) {
+                        for (size_t i = 0; i < values.size(); i++)
+                            output[i] = static_cast<T>(std::bit_cast<double>(values[i]));
+                    });
+                    return;
+                default:
+                    break;
+            }
+        }
+
+    }
+
+    // Decodes values stored back to back in data into the result, converting them to T the same way a static_cast would
+    template<typename T> requires std::is_arithmetic_v<T>
+    void decodeValues(const ValueEncoding &encoding, const u8 *data, std::span<T> result) {
+        switch (encoding.type) {
+            using enum ValueEncoding::Type;
+            case Unsigned:
+            case Signed:
+                impl::decodeInteger(encoding, data, result);
+                break;
+            case Float:
+                impl::decodeFloat(encoding, data, result);
+                break;
+            case Boolean:
+                for (size_t i = 0; i < result.size(); i++)
+                    result[i] = static_cast<T>(data[i] != 0x00);
+                break;
+            case Character:
+                for (size_t i = 0; i < result.size(); i++)
+                    result[i] = static_cast<T>(char(data[i]));
+                break;
+        }
+    }
+
+}
@@ -13,13 +13,16 @@
 #include <pl/api.hpp>
 
 #include <pl/core/log_console.hpp>
+#include <pl/core/memory_profiler.hpp>
+#include <pl/core/statistics.hpp>
+#include <pl/core/tracer.hpp>
 #include <pl/core/token.hpp>
 #include <pl/core/errors/error.hpp>
 
 #include <pl/helpers/types.hpp>
+#include <pl/helpers/static_interval_index.hpp>
 
 #include <wolv/io/fs.hpp>
-#include <wolv/container/interval_tree.hpp>
 
 namespace hex::prv {
     class Provider;
@@ -182,6 +185,30 @@ namespace pl {
          */
         void setLogCallback(const core::LogConsole::Callback &callback);
 
+        /**
+         * @brief Sets a callback that receives buffered log messages in batches instead of one by one
+         * @note Only used while log buffering is enabled, takes precedence over the regular log callback
+         * @param callback Callback to call
+         */
+        void setLogBatchCallback(const core::LogConsole::BatchCallback &callback);
+
+        /**
+         * @brief Collects log messages in a bounded buffer instead of delivering each one as soon as it's logged
+         * @note Messages are delivered once the buffer is full and at the end of every execution
+         * @note If a background thread is used, callbacks get invoked from that thread
+         * @param capacity Maximum number of buffered messages. 0 disables buffering
+         * @param backgroundThread Whether a background thread should periodically deliver the buffered messages
+         */
+        void setLogBuffering(size_t capacity, bool backgroundThread = false);
+
+        /**
+         * @brief Limits how many messages of a log level get delivered per second
+         * @note Dropped messages are reported by a single summary message
+         * @param level Log level to limit
+         * @param messagesPerSecond Maximum number of messages per second. 0 disables the limit
+         */
+        void setLogRateLimit(core::LogConsole::Level level, u64 messagesPerSecond);
+
         /**
          * @brief Gets the error that occurred during the last execution
          * @return Error
@@ -234,6 +261,16 @@ namespace pl {
          */
         [[nodiscard]] std::vector<ptrn::Pattern *> getPatternsAtAddress(u64 address, u64 section = 0x00) const;
 
+        /**
+         * @brief Gets all patterns that overlap with the given address range in a single lookup
+         * @note Doesn't modify any patterns so it can be called from multiple threads at once while the runtime isn't running
+         * @param start Start address of the range
+         * @param end End address of the range, inclusive
+         * @param section Section id
+         * @return Overlapping patterns together with the part of them inside the range, sorted by their start address
+         */
+        [[nodiscard]] std::vector<api::PatternRange> getPatternsInRange(u64 start, u64 end, u64 section = 0x00) const;
+
         /**
          * @brief Resets the runtime
          */
@@ -255,6 +292,42 @@ namespace pl {
             return this->m_runningTime;
         }
 
+        /**
+         * @brief Gets the statistics collected during the last execution
+         * @note Contains per-phase timings as well as counters for data accesses, pattern lifetimes and function calls
+         * @return Statistics of the last execution
+         */
+        [[nodiscard]] const core::Statistics& getStatistics() const;
+
+        /**
+         * @brief Enables or disables recording of trace events
+         * @note Recorded events are cleared at the start of every execution
+         * @param enabled Whether to record trace events
+         */
+        void setTracingEnabled(bool enabled);
+
+        /**
+         * @brief Gets the tracer that records spans of the execution phases
+         * @note The tracer is thread safe and can be used to record additional spans, e.g. from formatters
+         * @return Tracer
+         */
+        [[nodiscard]] core::Tracer& getTracer() const;
+
+        /**
+         * @brief Enables or disables attribution of pattern, heap and section memory to the type declarations that allocated it
+         * @note Profiling data is cleared at the start of every execution
+         * @param enabled Whether to profile memory usage
+         */
+        void setMemoryProfilingEnabled(bool enabled);
+
+        /**
+         * @brief Gets the memory consumers recorded during the last execution, sorted by the number of bytes they use
+         * @note Pattern sizes include the pattern object and the memory it owns, but not the patterns it contains
+         * @param atHighWaterMark Whether to return the usage at the point of highest memory usage instead of the usage at the end of the execution
+         * @return Memory consumers
+         */
+        [[nodiscard]] std::vector<core::MemoryProfiler::Consumer> getMemoryConsumers(bool atHighWaterMark = false) const;
+
         /**
          * @brief Adds a new built-in function to the pattern language
          * @param ns Namespace of the function
@@ -308,7 +381,7 @@ namespace pl {
         std::optional<core::err::PatternLanguageError> m_currError;
 
         std::map<u64, std::vector<std::shared_ptr<ptrn::Pattern>>> m_patterns;
-        std::map<u64, wolv::container::IntervalTree<ptrn::Pattern*, u64, 5>> m_flattenedPatterns;
+        std::map<u64, hlp::StaticIntervalIndex<ptrn::Pattern*>> m_flattenedPatterns;
         std::vector<std::function<void(PatternLanguage&)>> m_cleanupCallbacks;
         std::vector<std::shared_ptr<core::ast::ASTNode>> m_currAST;
 
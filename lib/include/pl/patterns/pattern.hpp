@@ -5,12 +5,15 @@
 #include <pl/pattern_visitor.hpp>
 #include <pl/helpers/types.hpp>
 #include <pl/helpers/utils.hpp>
+#include <pl/helpers/value_encoding.hpp>
 
 #include <fmt/format.h>
 
 #include <wolv/utils/core.hpp>
 #include <wolv/utils/guards.hpp>
 
+#include <limits>
+#include <span>
 #include <string>
 
 namespace pl::ptrn {
@@ -64,9 +67,16 @@ namespace pl::ptrn {
             : m_evaluator(evaluator), m_offset(offset), m_size(size) {
 
             if (evaluator != nullptr) {
+                auto lock = evaluator->lockSharedState();
+
                 this->m_color       = evaluator->getNextPatternColor();
                 this->m_manualColor = false;
+                evaluator->m_statistics.patternsCreated++;
                 evaluator->patternCreated(this);
+
+                // Only patterns that passed the pattern limit check get destroyed again and can be tracked
+                if (evaluator->m_memoryProfiler.isEnabled()) [[unlikely]]
+                    evaluator->m_memoryProfiler.patternCreated(this);
             }
         }
 
@@ -81,6 +91,7 @@ namespace pl::ptrn {
             this->m_initialized = other.m_initialized;
             this->m_constant = other.m_constant;
             this->m_variableName = other.m_variableName;
+            this->m_arrayIndex = other.m_arrayIndex;
             this->m_typeName = other.m_typeName;
 
             if (other.m_cachedDisplayValue != nullptr)
@@ -89,29 +100,52 @@ namespace pl::ptrn {
                 this->m_attributes = std::make_unique<std::map<std::string, std::vector<core::Token::Literal>>>(*other.m_attributes);
 
             if (this->m_evaluator != nullptr) {
+                auto lock = this->m_evaluator->lockSharedState();
+
+                this->m_evaluator->m_statistics.patternsCreated++;
+                this->m_evaluator->m_statistics.patternClones++;
                 this->m_evaluator->patternCreated(this);
+                if (this->m_evaluator->m_memoryProfiler.isEnabled()) [[unlikely]]
+                    this->m_evaluator->m_memoryProfiler.patternCreated(this);
             }
         }
 
         virtual ~Pattern() {
             if (this->m_evaluator != nullptr) {
+                auto lock = this->m_evaluator->lockSharedState();
+
+                this->m_evaluator->m_statistics.patternsDestroyed++;
+                if (this->m_evaluator->m_memoryProfiler.isEnabled()) [[unlikely]]
+                    this->m_evaluator->m_memoryProfiler.patternDestroyed(this);
                 this->m_evaluator->patternDestroyed(this);
             }
         }
 
         virtual std::unique_ptr<Pattern> clone() const = 0;
 
+        // Size of the pattern object and the memory it owns, not including the patterns it contains
+        [[nodiscard]] virtual size_t getMemoryUsage() const {
+            return sizeof(Pattern) + this->getOwnedMemoryUsage();
+        }
+
         [[nodiscard]] u64 getOffset() const { return this->m_offset; }
         [[nodiscard]] virtual u128 getOffsetForSorting() const { return this->getOffset() << 3; }
         [[nodiscard]] u32 getHeapAddress() const { return this->getOffset() >> 32; }
         void setAbsoluteOffset(u64 offset) {
-            if (this->m_offset != offset) {
-                if (this->m_evaluator != nullptr)
-                    this->m_evaluator->patternDestroyed(this);
+            if (this->m_offset == offset)
+                return;
+
+            // Only the references to pattern local storage depend on the offset
+            if (this->m_evaluator == nullptr || !this->isPatternLocal()) {
                 this->m_offset = offset;
-                if (this->m_evaluator != nullptr)
-                    this->m_evaluator->patternCreated(this);
+                return;
             }
+
+            auto lock = this->m_evaluator->lockSharedState();
+
+            this->m_evaluator->patternDestroyed(this);
+            this->m_offset = offset;
+            this->m_evaluator->patternCreated(this);
         }
         virtual void setOffset(u64 offset) {
             setAbsoluteOffset(offset);
@@ -122,14 +156,24 @@ namespace pl::ptrn {
         void setSize(size_t size) { this->m_size = size; }
 
         [[nodiscard]] std::string getVariableName() const {
-            if (this->m_variableName.empty())
+            if (this->m_arrayIndex != NoArrayIndex)
+                return fmt::format("[{}]", this->m_arrayIndex);
+            else if (this->m_variableName.empty())
                 return fmt::format("{} @ 0x{:02X}", this->getTypeName(), this->getOffset());
             else
                 return this->m_variableName;
         }
         void setVariableName(const std::string &name) {
-            if (!name.empty())
+            if (!name.empty()) {
                 this->m_variableName = name;
+                this->m_arrayIndex = NoArrayIndex;
+            }
+        }
+
+        // Names the pattern after its index in an array. The name is only formatted when it's actually requested
+        void setArrayIndex(u64 index) {
+            this->m_variableName.clear();
+            this->m_arrayIndex = index;
         }
 
         [[nodiscard]] std::string getComment() const {
@@ -213,6 +257,21 @@ namespace pl::ptrn {
             if (this->m_cachedDisplayValue != nullptr)
                 return *this->m_cachedDisplayValue;
 
+            // Patterns that don't call any functions to be formatted only read their data, which doesn't need the lock
+            if (this->m_evaluator->isConcurrentAccessEnabled() && this->getReadFormatterFunction().empty() && this->getTransformFunction().empty()) {
+                try {
+                    this->m_cachedDisplayValue = std::make_unique<std::string>(this->formatDisplayValue());
+                } catch (core::err::EvaluatorError::Exception &e) {
+                    this->m_cachedDisplayValue = std::make_unique<std::string>(e.getShortMessage());
+                } catch (std::exception &e) {
+                    this->m_cachedDisplayValue = std::make_unique<std::string>(e.what());
+                }
+
+                return *this->m_cachedDisplayValue;
+            }
+
+            auto lock = this->m_evaluator->lockSharedState();
+
             try {
                 auto startOffset = this->m_evaluator->getReadOffset();
                 this->m_evaluator->setReadOffset(this->getOffset());
@@ -228,6 +287,9 @@ namespace pl::ptrn {
                 this->m_cachedDisplayValue = std::make_unique<std::string>(result);
 
                 return result;
+            } catch (core::err::EvaluatorError::Exception &e) {
+                this->m_cachedDisplayValue = std::make_unique<std::string>(e.getShortMessage());
+                return *this->m_cachedDisplayValue;
             } catch(std::exception &e) {
                 this->m_cachedDisplayValue = std::make_unique<std::string>(e.what());
                 return *this->m_cachedDisplayValue;
@@ -336,6 +398,16 @@ namespace pl::ptrn {
         [[nodiscard]] virtual bool operator!=(const Pattern &other) const final { return !operator==(other); }
         [[nodiscard]] virtual bool operator==(const Pattern &other) const = 0;
 
+        // How the value is stored if it's a plain value that can be decoded in bulk without going through the pattern
+        [[nodiscard]] virtual std::optional<hlp::ValueEncoding> getValueEncoding() const {
+            return std::nullopt;
+        }
+
+        // Whether getBytes() returns exactly the data the pattern covers so it can be read in one go
+        [[nodiscard]] virtual bool hasContiguousBytes() const {
+            return this->getTransformFunction().empty();
+        }
+
         virtual const std::vector<u8>& getBytes() {
             if (this->m_cachedBytes != nullptr)
                 return *this->m_cachedBytes;
@@ -352,8 +424,7 @@ namespace pl::ptrn {
                 }, this->getValue());
                 std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
             } else {
-                result.resize(this->getSize());
-                this->getEvaluator()->readData(this->getOffset(), result.data(), result.size(), this->getSection());
+                result = this->readBytes();
             }
 
             this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
@@ -397,7 +468,7 @@ namespace pl::ptrn {
             }
         }
 
-        void clearFormatCache() {
+        virtual void clearFormatCache() {
             if (this->m_cachedDisplayValue == nullptr)
                 return;
 
@@ -410,7 +481,7 @@ namespace pl::ptrn {
             }
         }
 
-        void clearByteCache() {
+        virtual void clearByteCache() {
             if (this->m_cachedBytes == nullptr)
                 return;
 
@@ -484,39 +555,98 @@ namespace pl::ptrn {
         std::optional<std::endian> m_endian;
 
         [[nodiscard]] core::Token::Literal transformValue(const core::Token::Literal &value) const {
+            const auto transformFunction = this->getTransformFunction();
+            if (transformFunction.empty())
+                return value;
+
             auto evaluator = this->getEvaluator();
-            if (auto transformFunc = evaluator->findFunction(this->getTransformFunction()); transformFunc.has_value())
+            auto lock = evaluator->lockSharedState();
+            if (auto transformFunc = evaluator->findFunction(transformFunction); transformFunc.has_value())
                 if (auto result = transformFunc->func(evaluator, { value }); result.has_value())
                     return *result;
 
             return value;
         }
 
+        [[nodiscard]] std::optional<hlp::ValueEncoding> createValueEncoding(hlp::ValueEncoding::Type type) const {
+            if (!this->getTransformFunction().empty() || this->getSize() > std::numeric_limits<u8>::max())
+                return std::nullopt;
+
+            hlp::ValueEncoding encoding = { type, u8(this->getSize()), this->getEndian() };
+            if (!encoding.isDecodable())
+                return std::nullopt;
+
+            return encoding;
+        }
+
+        // Decodes values of the given encoding that are stored back to back starting at offset
+        template<typename T>
+        void readEncodedValues(const hlp::ValueEncoding &encoding, u64 offset, std::span<T> values) const {
+            const size_t valuesPerChunk = std::max<size_t>(0x10000 / encoding.size, 1);
+
+            std::vector<u8> buffer(std::min(values.size(), valuesPerChunk) * encoding.size);
+            for (size_t start = 0; start < values.size(); start += valuesPerChunk) {
+                const auto count = std::min(valuesPerChunk, values.size() - start);
+                this->getEvaluator()->readData(offset + start * encoding.size, buffer.data(), count * encoding.size, this->getSection());
+
+                hlp::decodeValues(encoding, buffer.data(), values.subspan(start, count));
+            }
+        }
+
+        [[nodiscard]] std::vector<u8> readBytes() const {
+            std::vector<u8> result(this->getSize());
+            this->getEvaluator()->readData(this->getOffset(), result.data(), result.size(), this->getSection());
+
+            return result;
+        }
+
+        // Checks if the children cover all of this pattern's data back to back without any gaps
+        template<typename T>
+        [[nodiscard]] bool areContiguous(const std::vector<std::shared_ptr<T>> &children) const {
+            auto offset = this->getOffset();
+            for (const auto &child : children) {
+                if (child->getOffset() != offset || child->getSection() != this->getSection() || !child->hasContiguousBytes())
+                    return false;
+
+                offset += child->getSize();
+            }
+
+            return offset == this->getOffset() + this->getSize();
+        }
+
         [[nodiscard]] virtual std::string formatDisplayValue() = 0;
 
+        // Only copies the pattern if the formatter function could hold on to it after it returned.
+        // Otherwise the function gets a non-owning reference to the pattern itself
+        [[nodiscard]] std::string formatDisplayValue(const std::string &value, const Pattern *pattern) const {
+            const auto &formatterFunctionName = this->getReadFormatterFunction();
+            if (formatterFunctionName.empty())
+                return value;
+
+            auto lock = this->m_evaluator->lockSharedState();
+
+            const auto function = this->m_evaluator->findFunction(formatterFunctionName);
+            if (!function.has_value())
+                return "";
+
+            if (function->retainsParameters)
+                return this->callFormatterFunction(*function, core::Token::Literal(std::shared_ptr<Pattern>(pattern->clone())));
+            else
+                return this->callFormatterFunction(*function, core::Token::Literal(std::shared_ptr<Pattern>(std::shared_ptr<Pattern>(), const_cast<Pattern *>(pattern))));
+        }
+
         [[nodiscard]] std::string formatDisplayValue(const std::string &value, const core::Token::Literal &literal) const {
             const auto &formatterFunctionName = this->getReadFormatterFunction();
             if (formatterFunctionName.empty())
                 return value;
-            else {
-                try {
-                    const auto function = this->m_evaluator->findFunction(formatterFunctionName);
-                    if (function.has_value()) {
-                        auto result = function->func(this->m_evaluator, { literal });
 
-                        if (result.has_value()) {
-                            return result->toString(true);
-                        } else {
-                            return "";
-                        }
-                    } else {
-                        return "";
-                    }
+            auto lock = this->m_evaluator->lockSharedState();
 
-                } catch (core::err::EvaluatorError::Exception &error) {
-                    return error.what();
-                }
-            }
+            const auto function = this->m_evaluator->findFunction(formatterFunctionName);
+            if (!function.has_value())
+                return "";
+
+            return this->callFormatterFunction(*function, literal);
         }
 
         template<typename T>
@@ -526,11 +656,60 @@ namespace pl::ptrn {
                    this->m_size == other.m_size &&
                    (this->m_attributes == nullptr || other.m_attributes == nullptr || *this->m_attributes == *other.m_attributes) &&
                    (this->m_endian == other.m_endian || (!this->m_endian.has_value() && other.m_endian == std::endian::native) || (!other.m_endian.has_value() && this->m_endian == std::endian::native)) &&
-                   this->m_variableName == other.m_variableName &&
+                   this->getVariableName() == other.getVariableName() &&
                    this->m_typeName == other.m_typeName &&
                    this->m_section == other.m_section;
         }
 
+    protected:
+        [[nodiscard]] static size_t getStringMemoryUsage(const std::string &string) {
+            // Short strings are stored inside the string object itself
+            return string.capacity() > std::string().capacity() ? string.capacity() + 1 : 0;
+        }
+
+        // Needs to be called with the shared state lock held
+        [[nodiscard]] std::string callFormatterFunction(const api::Function &function, const core::Token::Literal &literal) const {
+            try {
+                auto result = function.func(this->m_evaluator, { literal });
+
+                if (result.has_value())
+                    return result->toString(true);
+                else
+                    return "";
+            } catch (core::err::EvaluatorError::Exception &error) {
+                return error.getShortMessage();
+            }
+        }
+
+        // Patterns that size more than the base pattern call this first thing in their destructor, while all of their members are still alive
+        void measureBeforeDestruction() const {
+            if (this->m_evaluator != nullptr && this->m_evaluator->m_memoryProfiler.isEnabled()) [[unlikely]] {
+                auto lock = this->m_evaluator->lockSharedState();
+                this->m_evaluator->m_memoryProfiler.patternDestroying(this);
+            }
+        }
+
+        // Heap memory owned by the members of the base pattern
+        [[nodiscard]] size_t getOwnedMemoryUsage() const {
+            size_t result = getStringMemoryUsage(this->m_variableName) + getStringMemoryUsage(this->m_typeName);
+
+            if (this->m_cachedDisplayValue != nullptr)
+                result += sizeof(std::string) + getStringMemoryUsage(*this->m_cachedDisplayValue);
+            if (this->m_cachedBytes != nullptr)
+                result += sizeof(std::vector<u8>) + this->m_cachedBytes->capacity();
+
+            if (this->m_attributes != nullptr) {
+                result += sizeof(*this->m_attributes);
+                for (const auto &[name, arguments] : *this->m_attributes) {
+                    // Every map node also stores its color and three links
+                    result += sizeof(std::pair<const std::string, std::vector<core::Token::Literal>>) + 4 * sizeof(void*);
+                    result += getStringMemoryUsage(name) + arguments.capacity() * sizeof(core::Token::Literal);
+                }
+            }
+
+            return result;
+        }
+
     protected:
         mutable std::unique_ptr<std::string> m_cachedDisplayValue;
         std::unique_ptr<std::vector<u8>> m_cachedBytes;
@@ -542,7 +721,10 @@ namespace pl::ptrn {
 
         std::unique_ptr<std::map<std::string, std::vector<core::Token::Literal>>> m_attributes;
 
+        constexpr static u64 NoArrayIndex = std::numeric_limits<u64>::max();
+
         std::string m_variableName;
+        u64 m_arrayIndex = NoArrayIndex;
         std::string m_typeName;
 
         u64 m_offset  = 0x00;
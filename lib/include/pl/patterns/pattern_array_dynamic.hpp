@@ -19,10 +19,18 @@ namespace pl::ptrn {
             this->setEntries(std::move(entries));
         }
 
+        ~PatternArrayDynamic() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternArrayDynamic(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->m_entries.capacity() * sizeof(decltype(this->m_entries)::value_type);
+        }
+
         void setColor(u32 color) override {
             Pattern::setColor(color);
             for (auto &entry : this->m_entries)
@@ -156,7 +164,7 @@ namespace pl::ptrn {
 
             result += " ]";
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -191,7 +199,34 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            return Pattern::formatDisplayValue("[ ... ]", this->clone());
+            return Pattern::formatDisplayValue("[ ... ]", this);
+        }
+
+        // Encoding of the entries if they're all plain values of the same type stored back to back, so they can be read in bulk using readValues()
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getEntryEncoding() const {
+            return this->getEntryEncoding(0, this->m_entries.size());
+        }
+
+        // Decodes the values of the entries starting at index start into the buffer without visiting any of them.
+        // Returns false if the entries aren't uniform plain values or the range exceeds the array
+        template<typename T>
+        bool readValues(u64 start, std::span<T> values) const {
+            if (start > this->m_entries.size() || values.size() > this->m_entries.size() - start)
+                return false;
+            if (values.empty())
+                return true;
+
+            const auto encoding = this->getEntryEncoding(start, start + values.size());
+            if (!encoding.has_value())
+                return false;
+
+            this->readEncodedValues(*encoding, this->m_entries[start]->getOffset(), values);
+
+            return true;
+        }
+
+        [[nodiscard]] bool hasContiguousBytes() const override {
+            return this->areContiguous(this->m_entries);
         }
 
         const std::vector<u8>& getBytes() override {
@@ -200,16 +235,39 @@ namespace pl::ptrn {
 
             std::vector<u8> result;
 
-            this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
-                auto bytes = entry->getBytes();
-                std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
-            });
+            if (this->hasContiguousBytes()) {
+                result = this->readBytes();
+            } else {
+                this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
+                    auto bytes = entry->getBytes();
+                    std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
+                });
+            }
 
             this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
 
             return *this->m_cachedBytes;
         }
 
+    private:
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getEntryEncoding(u64 start, u64 end) const {
+            if (start >= end)
+                return std::nullopt;
+
+            const auto &first = this->m_entries[start];
+            const auto encoding = first->getValueEncoding();
+            if (!encoding.has_value() || first->getSection() != this->getSection())
+                return std::nullopt;
+
+            for (u64 i = start + 1; i < end; i++) {
+                const auto &entry = this->m_entries[i];
+                if (entry->getOffset() != first->getOffset() + (i - start) * encoding->size || entry->getSection() != this->getSection() || entry->getValueEncoding() != encoding)
+                    return std::nullopt;
+            }
+
+            return encoding;
+        }
+
     private:
         std::vector<std::shared_ptr<Pattern>> m_entries;
     };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pl/patterns/pattern.hpp>
+#include <pl/patterns/pattern_bitfield.hpp>
 
 namespace pl::ptrn {
 
@@ -15,10 +16,18 @@ namespace pl::ptrn {
             this->setEntries(other.getTemplate()->clone(), other.getEntryCount());
         }
 
+        ~PatternArrayStatic() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternArrayStatic(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->m_highlightTemplates.capacity() * sizeof(decltype(this->m_highlightTemplates)::value_type);
+        }
+
         [[nodiscard]] std::shared_ptr<Pattern> getEntry(size_t index) const override {
             std::shared_ptr<Pattern> highlightTemplate = this->m_template->clone();
             highlightTemplate->setOffset(this->getOffset() + index * highlightTemplate->getSize());
@@ -41,16 +50,39 @@ namespace pl::ptrn {
             };
 
             auto &entry = this->m_template;
-            for (u64 index = start; index < std::min<u64>(end, this->m_entryCount); index++) {
-                entry->clearFormatCache();
-                entry->clearByteCache();
+            const auto entrySize = entry->getSize();
+            const auto endIndex  = std::min<u64>(end, this->m_entryCount);
+
+            // Bitfields decode their fields from a copy of their data. Give it the data of many entries at once
+            auto bitfield = dynamic_cast<PatternBitfieldMember *>(entry.get());
+            u64 cachedEnd = 0;
+
+            for (u64 index = start; index < endIndex; index++) {
+                // Keep the data read for the following bitfield entries, it's dropped once all of them have been visited
+                if (bitfield != nullptr) {
+                    bitfield->Pattern::clearFormatCache();
+                    bitfield->Pattern::clearByteCache();
+                } else {
+                    entry->clearFormatCache();
+                    entry->clearByteCache();
+                }
 
-                entry->setVariableName(fmt::format("[{0}]", index));
-                entry->setOffset(this->getOffset() + index * this->m_template->getSize());
+                const auto offset = this->getOffset() + index * entrySize;
+                if (bitfield != nullptr && entrySize > 0 && offset + entrySize > cachedEnd) {
+                    const auto cacheSize = std::min<u64>((endIndex - index) * entrySize, std::max<u64>(BitfieldCacheSize / entrySize, 1) * entrySize);
+                    bitfield->cacheBytes(offset, cacheSize);
+                    cachedEnd = offset + cacheSize;
+                }
+
+                entry->setArrayIndex(index);
+                entry->setOffset(offset);
                 evaluator->setCurrentArrayIndex(index);
 
                 fn(index, entry.get());
             }
+
+            if (bitfield != nullptr)
+                bitfield->clearByteCache();
         }
 
         void setOffset(u64 offset) override {
@@ -189,7 +221,7 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            return Pattern::formatDisplayValue("[ ... ]", this->clone());
+            return Pattern::formatDisplayValue("[ ... ]", this);
         }
 
         [[nodiscard]] std::string toString() const override {
@@ -218,7 +250,35 @@ namespace pl::ptrn {
 
             result += " ]";
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
+        }
+
+        // Encoding of the entries if they're plain values that can be read in bulk using readValues()
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getEntryEncoding() const {
+            if (this->m_template == nullptr || this->m_template->getSection() != this->getSection())
+                return std::nullopt;
+
+            return this->m_template->getValueEncoding();
+        }
+
+        // Decodes the values of the entries starting at index start into the buffer without visiting any of them.
+        // Returns false if the entries aren't plain values or the range exceeds the array
+        template<typename T>
+        bool readValues(u64 start, std::span<T> values) const {
+            const auto encoding = this->getEntryEncoding();
+            if (!encoding.has_value() || start > this->m_entryCount || values.size() > this->m_entryCount - start)
+                return false;
+
+            this->readEncodedValues(*encoding, this->getOffset() + start * encoding->size, values);
+
+            return true;
+        }
+
+        // All entries share the same layout so checking the template is enough
+        [[nodiscard]] bool hasContiguousBytes() const override {
+            return this->m_template->getSection() == this->getSection() &&
+                   this->m_template->getSize() * this->m_entryCount == this->getSize() &&
+                   this->m_template->hasContiguousBytes();
         }
 
         const std::vector<u8>& getBytes() override {
@@ -227,11 +287,15 @@ namespace pl::ptrn {
 
             std::vector<u8> result;
 
-            this->forEachEntry(0, this->getEntryCount(), [&](u64, Pattern *entry) {
-                auto &bytes = entry->getBytes();
+            if (this->hasContiguousBytes()) {
+                result = this->readBytes();
+            } else {
+                this->forEachEntry(0, this->getEntryCount(), [&](u64, Pattern *entry) {
+                    auto &bytes = entry->getBytes();
 
-                std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
-            });
+                    std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
+                });
+            }
 
             this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
 
@@ -239,6 +303,8 @@ namespace pl::ptrn {
         }
 
     private:
+        constexpr static u64 BitfieldCacheSize = 0x10000;
+
         std::shared_ptr<Pattern> m_template = nullptr;
         mutable std::vector<std::shared_ptr<Pattern>> m_highlightTemplates;
         size_t m_entryCount = 0;
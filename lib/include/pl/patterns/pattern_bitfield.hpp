@@ -9,6 +9,8 @@ namespace pl::ptrn {
     public:
         using Pattern::Pattern;
 
+        PatternBitfieldMember(const PatternBitfieldMember &other) : Pattern(other) { }
+
         virtual void setParentBitfield(PatternBitfieldMember *parent) = 0;
 
         [[nodiscard]] virtual PatternBitfieldMember const* getParentBitfield() const = 0;
@@ -36,6 +38,9 @@ namespace pl::ptrn {
 
         [[nodiscard]] virtual bool isPadding() const { return false; }
 
+        // Bitfield members don't start or end on byte boundaries
+        [[nodiscard]] bool hasContiguousBytes() const override { return false; }
+
         [[nodiscard]] u128 getOffsetForSorting() const override {
             return this->getTotalBitOffset();
         }
@@ -43,6 +48,64 @@ namespace pl::ptrn {
         [[nodiscard]] u128 getSizeForSorting() const override {
             return this->getBitSize();
         }
+
+        // Returns the given bytes from this bitfield's copy of its data. The data is read once and then shared by all
+        // members so they don't read the same bytes again for every single field
+        [[nodiscard]] const u8 *getCachedBytes(u64 offset, size_t size, u64 section) const {
+            const auto writeCount = this->getEvaluator()->getDataWriteCount();
+
+            auto &cache = this->m_byteCache;
+            if (cache == nullptr || cache->section != section || cache->writeCount != writeCount || offset < cache->offset || offset - cache->offset + size > cache->bytes.size()) {
+                const auto coveredSize = (this->getBitOffset() + this->getBitSize() + 7) / 8;
+                if (section != this->getSection() || offset < this->getOffset() || offset - this->getOffset() + size > coveredSize)
+                    return nullptr;
+
+                this->cacheBytes(this->getOffset(), coveredSize);
+            }
+
+            return cache->bytes.data() + (offset - cache->offset);
+        }
+
+        // Replaces the copy of the data with the given range. Arrays moving a single bitfield over all of their
+        // entries use this to read the data of many entries at once
+        void cacheBytes(u64 offset, size_t size) const {
+            if (this->m_byteCache == nullptr)
+                this->m_byteCache = std::make_unique<ByteCache>();
+
+            auto &cache = *this->m_byteCache;
+            cache.offset     = offset;
+            cache.section    = this->getSection();
+            cache.writeCount = this->getEvaluator()->getDataWriteCount();
+            cache.bytes.resize(size);
+
+            this->getEvaluator()->readData(offset, cache.bytes.data(), size, cache.section);
+        }
+
+        // The copy of the data is dropped together with the other caches so changes to the data made by the host show up
+        void clearFormatCache() override {
+            this->m_byteCache.reset();
+            Pattern::clearFormatCache();
+        }
+
+        void clearByteCache() override {
+            this->m_byteCache.reset();
+            Pattern::clearByteCache();
+        }
+
+    protected:
+        [[nodiscard]] size_t getByteCacheMemoryUsage() const {
+            return this->m_byteCache == nullptr ? 0 : sizeof(ByteCache) + this->m_byteCache->bytes.capacity();
+        }
+
+    private:
+        struct ByteCache {
+            u64 offset = 0;
+            u64 section = 0;
+            u64 writeCount = 0;
+            std::vector<u8> bytes;
+        };
+
+        mutable std::unique_ptr<ByteCache> m_byteCache;
     };
 
     class PatternBitfieldField : public PatternBitfieldMember {
@@ -57,11 +120,27 @@ namespace pl::ptrn {
             this->m_parentBitfield = other.m_parentBitfield;
         }
 
+        ~PatternBitfieldField() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternBitfieldField(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->getByteCacheMemoryUsage();
+        }
+
         [[nodiscard]] u128 readValue() const {
+            const auto readSize = core::Evaluator::getBitsReadSize(this->getBitOffset(), this->getBitSize());
+            if (auto bytes = this->getTopmostBitfield().getCachedBytes(this->getOffset(), readSize, this->getSection()); bytes != nullptr) {
+                u128 value = 0;
+                std::memcpy(&value, bytes, readSize);
+
+                return core::Evaluator::extractBits(value, this->getBitOffset(), this->getBitSize(), this->getEndian());
+            }
+
             return this->getEvaluator()->readBits(this->getOffset(), this->getBitOffset(), this->getBitSize(), this->getSection(), this->getEndian());
         }
 
@@ -219,11 +298,19 @@ namespace pl::ptrn {
         using PatternBitfieldField::PatternBitfieldField;
 
         void setEnumValues(const std::vector<PatternEnum::EnumValue> &enumValues) {
-            this->m_enumValues = enumValues;
+            this->m_valueTable = std::make_shared<const PatternEnum::ValueTable>(enumValues);
         }
 
-        const auto& getEnumValues() const {
-            return this->m_enumValues;
+        void setValueTable(std::shared_ptr<const PatternEnum::ValueTable> valueTable) {
+            this->m_valueTable = std::move(valueTable);
+        }
+
+        [[nodiscard]] const std::shared_ptr<const PatternEnum::ValueTable> &getValueTable() const {
+            return this->m_valueTable;
+        }
+
+        const std::vector<PatternEnum::EnumValue>& getEnumValues() const {
+            return PatternEnum::getEnumValues(this->m_valueTable);
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -231,34 +318,34 @@ namespace pl::ptrn {
                 return false;
 
             auto &otherEnum = *static_cast<const PatternBitfieldFieldEnum *>(&other);
-            if (this->m_enumValues.size() != otherEnum.m_enumValues.size())
-                return false;
-
-            for (u64 i = 0; i < this->m_enumValues.size(); i++) {
-                if (this->m_enumValues[i] != otherEnum.m_enumValues[i])
-                    return false;
-            }
+            return this->m_valueTable == otherEnum.m_valueTable || this->getEnumValues() == otherEnum.getEnumValues();
+        }
 
-            return true;
+        ~PatternBitfieldFieldEnum() override {
+            this->measureBeforeDestruction();
         }
 
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternBitfieldFieldEnum(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->getByteCacheMemoryUsage();
+        }
+
         std::string formatDisplayValue() override {
             auto value = this->readValue();
-            auto enumName = PatternEnum::getEnumName(this->getTypeName(), value, this->getEnumValues());
+            auto enumName = PatternEnum::getEnumName(this->getTypeName(), value, this->m_valueTable.get());
             return Pattern::formatDisplayValue(fmt::format("{} (0x{:X})", enumName, value), value);
         }
 
         [[nodiscard]] std::string toString() const override {
-            auto enumName = PatternEnum::getEnumName(this->getTypeName(), this->readValue(), this->getEnumValues());
+            auto enumName = PatternEnum::getEnumName(this->getTypeName(), this->readValue(), this->m_valueTable.get());
             return Pattern::formatDisplayValue(enumName, this->getValue());
         }
 
     private:
-        std::vector<PatternEnum::EnumValue> m_enumValues;
+        std::shared_ptr<const PatternEnum::ValueTable> m_valueTable;
     };
 
     class PatternBitfieldArray : public PatternBitfieldMember,
@@ -270,19 +357,31 @@ namespace pl::ptrn {
 
         PatternBitfieldArray(const PatternBitfieldArray &other) : PatternBitfieldMember(other) {
             std::vector<std::shared_ptr<Pattern>> entries;
-            for (const auto &entry : other.m_entries)
+            for (const auto &entry : other.m_entries) {
                 entries.push_back(entry->clone());
 
+                if (auto member = dynamic_cast<PatternBitfieldMember *>(entries.back().get()); member != nullptr)
+                    member->setParentBitfield(this);
+            }
+
             this->setEntries(std::move(entries));
 
             this->m_firstBitOffset = other.m_firstBitOffset;
             this->m_totalBitSize = other.m_totalBitSize;
         }
 
+        ~PatternBitfieldArray() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternBitfieldArray(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->getByteCacheMemoryUsage() + this->m_entries.capacity() * sizeof(decltype(this->m_entries)::value_type) + this->m_sortedEntries.capacity() * sizeof(decltype(this->m_sortedEntries)::value_type);
+        }
+
         void setParentBitfield(PatternBitfieldMember *parentBitfield) override {
             this->m_parentBitfield = parentBitfield;
         }
@@ -451,7 +550,7 @@ namespace pl::ptrn {
 
             result += " ]";
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -491,7 +590,7 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            return PatternBitfieldMember::formatDisplayValue("[ ... ]", this->clone());
+            return PatternBitfieldMember::formatDisplayValue("[ ... ]", this);
         }
 
         void sort(const std::function<bool (const Pattern *, const Pattern *)> &comparator) override {
@@ -540,18 +639,30 @@ namespace pl::ptrn {
                 : PatternBitfieldMember(evaluator, offset, (totalBitSize + 7) / 8), m_firstBitOffset(firstBitOffset), m_totalBitSize(totalBitSize) { }
 
         PatternBitfield(const PatternBitfield &other) : PatternBitfieldMember(other) {
-            for (auto &field : other.m_fields)
+            for (auto &field : other.m_fields) {
                 this->m_fields.push_back(field->clone());
 
+                if (auto member = dynamic_cast<PatternBitfieldMember *>(this->m_fields.back().get()); member != nullptr)
+                    member->setParentBitfield(this);
+            }
+
             this->m_parentBitfield = other.m_parentBitfield;
             this->m_firstBitOffset = other.m_firstBitOffset;
             this->m_totalBitSize = other.m_totalBitSize;
         }
 
+        ~PatternBitfield() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternBitfield(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->getByteCacheMemoryUsage() + this->m_fields.capacity() * sizeof(decltype(this->m_fields)::value_type) + this->m_sortedFields.capacity() * sizeof(decltype(this->m_sortedFields)::value_type);
+        }
+
         void setParentBitfield(PatternBitfieldMember *parentBitfield) override {
             this->m_parentBitfield = parentBitfield;
         }
@@ -689,16 +800,10 @@ namespace pl::ptrn {
 
             result += " }";
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
         }
 
         std::string formatDisplayValue() override {
-            std::vector<u8> bytes(this->getSize(), 0);
-            this->getEvaluator()->readData(this->getOffset(), bytes.data(), bytes.size(), this->getSection());
-
-            if (this->getEndian() == std::endian::little)
-                std::reverse(bytes.begin(), bytes.end());
-
             std::string valueString;
 
             for (const auto &pattern : this->m_fields) {
@@ -724,7 +829,7 @@ namespace pl::ptrn {
                 valueString.pop_back();
             }
 
-            return Pattern::formatDisplayValue(fmt::format("{{ {} }}", valueString), this->clone());
+            return Pattern::formatDisplayValue(fmt::format("{{ {} }}", valueString), this);
         }
 
         void setEndian(std::endian endian) override {
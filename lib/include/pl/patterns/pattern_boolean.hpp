@@ -14,10 +14,14 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
-            bool boolean = false;
+            u8 boolean = 0x00;
             this->getEvaluator()->readData(this->getOffset(), &boolean, 1, this->getSection());
 
-            return transformValue(boolean);
+            return transformValue(boolean != 0x00);
+        }
+
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getValueEncoding() const override {
+            return this->createValueEncoding(hlp::ValueEncoding::Type::Boolean);
         }
 
         std::vector<u8> getBytesOf(const core::Token::Literal &value) const override {
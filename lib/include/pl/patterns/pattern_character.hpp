@@ -20,6 +20,10 @@ namespace pl::ptrn {
             return transformValue(character);
         }
 
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getValueEncoding() const override {
+            return this->createValueEncoding(hlp::ValueEncoding::Type::Character);
+        }
+
         std::vector<u8> getBytesOf(const core::Token::Literal &value) const override {
             if (auto charValue = std::get_if<char>(&value); charValue != nullptr)
                 return wolv::util::toContainer<std::vector<u8>>(wolv::util::toBytes(*charValue));
@@ -2,6 +2,11 @@
 
 #include <pl/patterns/pattern.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <queue>
+
 namespace pl::ptrn {
 
     class PatternEnum : public Pattern {
@@ -14,14 +19,144 @@ namespace pl::ptrn {
             [[nodiscard]] bool operator!=(const EnumValue &other) const = default;
         };
 
+        /*
+         * Immutable lookup table from values to the entries of an enum. It's built once per enum type and shared by
+         * all patterns of that type.
+         * The entries are flattened into sorted, non-overlapping ranges that each map to the first entry containing
+         * them, so overlapping entries resolve the same way a linear search over the entries would.
+         * Compact enums are additionally expanded into a table that's indexed directly by the value.
+         */
+        class ValueTable {
+        public:
+            explicit ValueTable(std::vector<EnumValue> values) : m_values(std::move(values)) {
+                this->buildRanges();
+                this->buildDenseTable();
+            }
+
+            [[nodiscard]] const std::vector<EnumValue> &getValues() const {
+                return this->m_values;
+            }
+
+            // Returns the first entry containing the value or nullptr if there is none
+            [[nodiscard]] const EnumValue *find(u128 value) const {
+                if (!this->m_denseEntries.empty()) {
+                    if (value < this->m_denseStart || value - this->m_denseStart >= this->m_denseEntries.size())
+                        return nullptr;
+
+                    const auto index = this->m_denseEntries[size_t(value - this->m_denseStart)];
+                    return index == NoEntry ? nullptr : &this->m_values[index];
+                }
+
+                auto it = std::upper_bound(this->m_ranges.begin(), this->m_ranges.end(), value, [](u128 value, const Range &range) {
+                    return value < range.start;
+                });
+
+                if (it == this->m_ranges.begin())
+                    return nullptr;
+
+                --it;
+                return value <= it->end ? &this->m_values[it->index] : nullptr;
+            }
+
+        private:
+            constexpr static u32 NoEntry = std::numeric_limits<u32>::max();
+            constexpr static u128 MinDenseTableSize = 0x100;
+
+            struct Range {
+                u128 start, end;
+                u32 index;
+            };
+
+            void buildRanges() {
+                struct Bounds {
+                    u128 min, max;
+                };
+
+                std::vector<Bounds> bounds;
+                std::vector<u32> order;
+                bounds.reserve(this->m_values.size());
+                for (const auto &value : this->m_values) {
+                    bounds.push_back({ value.min.toUnsigned(), value.max.toUnsigned() });
+                    if (bounds.back().min <= bounds.back().max)
+                        order.push_back(u32(bounds.size() - 1));
+                }
+
+                std::stable_sort(order.begin(), order.end(), [&](u32 left, u32 right) {
+                    return bounds[left].min < bounds[right].min;
+                });
+
+                // Sweep over the values, the entry with the lowest index covering the current position wins
+                std::priority_queue<u32, std::vector<u32>, std::greater<>> active;
+                size_t next = 0;
+                u128 position = 0;
+                while (next < order.size() || !active.empty()) {
+                    if (active.empty())
+                        position = bounds[order[next]].min;
+
+                    for (; next < order.size() && bounds[order[next]].min <= position; next++)
+                        active.push(order[next]);
+
+                    while (!active.empty() && bounds[active.top()].max < position)
+                        active.pop();
+
+                    if (active.empty())
+                        continue;
+
+                    const auto index = active.top();
+                    auto end = bounds[index].max;
+                    if (next < order.size())
+                        end = std::min(end, bounds[order[next]].min - 1);
+
+                    if (!this->m_ranges.empty() && this->m_ranges.back().index == index && this->m_ranges.back().end + 1 == position)
+                        this->m_ranges.back().end = end;
+                    else
+                        this->m_ranges.push_back({ position, end, index });
+
+                    if (end == std::numeric_limits<u128>::max())
+                        break;
+
+                    position = end + 1;
+                }
+            }
+
+            void buildDenseTable() {
+                if (this->m_ranges.empty())
+                    return;
+
+                const auto start = this->m_ranges.front().start;
+                const auto span = this->m_ranges.back().end - start;
+                if (span >= std::max<u128>(MinDenseTableSize, u128(this->m_ranges.size()) * 4))
+                    return;
+
+                this->m_denseStart = start;
+                this->m_denseEntries.resize(size_t(span + 1), NoEntry);
+                for (const auto &range : this->m_ranges)
+                    std::fill(this->m_denseEntries.begin() + size_t(range.start - start), this->m_denseEntries.begin() + size_t(range.end - start) + 1, range.index);
+            }
+
+            std::vector<EnumValue> m_values;
+            std::vector<Range> m_ranges;
+
+            u128 m_denseStart = 0;
+            std::vector<u32> m_denseEntries;
+        };
+
     public:
         PatternEnum(core::Evaluator *evaluator, u64 offset, size_t size)
             : Pattern(evaluator, offset, size) { }
 
+        ~PatternEnum() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternEnum(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage();
+        }
+
         [[nodiscard]] core::Token::Literal getValue() const override {
             u128 value = 0;
             this->getEvaluator()->readData(this->getOffset(), &value, this->getSize(), this->getSection());
@@ -38,11 +173,19 @@ namespace pl::ptrn {
         }
 
         void setEnumValues(const std::vector<EnumValue> &enumValues) {
-            this->m_enumValues = enumValues;
+            this->m_valueTable = std::make_shared<const ValueTable>(enumValues);
+        }
+
+        void setValueTable(std::shared_ptr<const ValueTable> valueTable) {
+            this->m_valueTable = std::move(valueTable);
         }
 
-        const auto& getEnumValues() const {
-            return this->m_enumValues;
+        [[nodiscard]] const std::shared_ptr<const ValueTable> &getValueTable() const {
+            return this->m_valueTable;
+        }
+
+        const std::vector<EnumValue>& getEnumValues() const {
+            return getEnumValues(this->m_valueTable);
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -50,15 +193,7 @@ namespace pl::ptrn {
                 return false;
 
             auto &otherEnum = *static_cast<const PatternEnum *>(&other);
-            if (this->m_enumValues.size() != otherEnum.m_enumValues.size())
-                return false;
-
-            for (u64 i = 0; i < this->m_enumValues.size(); i++) {
-                if (this->m_enumValues[i] != otherEnum.m_enumValues[i])
-                    return false;
-            }
-
-            return true;
+            return this->m_valueTable == otherEnum.m_valueTable || this->getEnumValues() == otherEnum.getEnumValues();
         }
 
         void accept(PatternVisitor &v) override {
@@ -88,13 +223,25 @@ namespace pl::ptrn {
             return result;
         }
 
+        static std::string getEnumName(const std::string &typeName, u128 value, const ValueTable *valueTable) {
+            const auto entry = valueTable == nullptr ? nullptr : valueTable->find(value);
+
+            return typeName + "::" + (entry == nullptr ? "???" : entry->name);
+        }
+
+        static const std::vector<EnumValue>& getEnumValues(const std::shared_ptr<const ValueTable> &valueTable) {
+            static const std::vector<EnumValue> NoValues;
+
+            return valueTable == nullptr ? NoValues : valueTable->getValues();
+        }
+
         [[nodiscard]] std::string toString() const override {
             u128 value = this->getValue().toUnsigned();
-            return Pattern::formatDisplayValue(getEnumName(this->getTypeName(), value, this->m_enumValues), this->clone());
+            return Pattern::formatDisplayValue(getEnumName(this->getTypeName(), value, this->m_valueTable.get()), this);
         }
 
     private:
-        std::vector<EnumValue> m_enumValues;
+        std::shared_ptr<const ValueTable> m_valueTable;
     };
 
 }
\ No newline at end of file
@@ -14,7 +14,13 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
-            if (this->getSize() == 4) {
+            if (this->getSize() == 2) {
+                u16 data = 0;
+                this->getEvaluator()->readData(this->getOffset(), &data, 2, this->getSection());
+                data = hlp::changeEndianess(data, 2, this->getEndian());
+
+                return transformValue(double(hlp::float16ToFloat32(data)));
+            } else if (this->getSize() == 4) {
                 u32 data = 0;
                 this->getEvaluator()->readData(this->getOffset(), &data, 4, this->getSection());
                 data = hlp::changeEndianess(data, 4, this->getEndian());
@@ -35,6 +41,10 @@ namespace pl::ptrn {
             }
         }
 
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getValueEncoding() const override {
+            return this->createValueEncoding(hlp::ValueEncoding::Type::Float);
+        }
+
         std::vector<u8> getBytesOf(const core::Token::Literal &value) const override {
             auto doubleValue = value.toFloatingPoint();
             std::vector<u8> result;
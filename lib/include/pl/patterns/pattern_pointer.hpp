@@ -20,10 +20,18 @@ namespace pl::ptrn {
             }
         }
 
+        ~PatternPointer() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternPointer(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage();
+        }
+
         [[nodiscard]] core::Token::Literal getValue() const override {
             return transformValue(this->m_pointerType->getValue());
         }
@@ -152,7 +160,7 @@ namespace pl::ptrn {
         [[nodiscard]] std::string toString() const override {
             auto result = this->m_pointedAt->toString();
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
         }
 
     private:
@@ -21,6 +21,10 @@ namespace pl::ptrn {
             return transformValue(hlp::signExtend(this->getSize() * 8, data));
         }
 
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getValueEncoding() const override {
+            return this->createValueEncoding(hlp::ValueEncoding::Type::Signed);
+        }
+
         [[nodiscard]] std::string getFormattedName() const override {
             return this->getTypeName();
         }
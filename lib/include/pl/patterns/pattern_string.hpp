@@ -10,10 +10,18 @@ namespace pl::ptrn {
         PatternString(core::Evaluator *evaluator, u64 offset, size_t size)
             : Pattern(evaluator, offset, size) { }
 
+        ~PatternString() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternString(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage();
+        }
+
         [[nodiscard]] core::Token::Literal getValue() const override {
             return transformValue(this->getValue(this->getSize()));
         }
@@ -84,23 +92,28 @@ namespace pl::ptrn {
             return this->getSize();
         }
 
+        // All characters are visited through a single pattern that's moved from one to the next
         void forEachEntry(u64 start, u64 end, const std::function<void (u64, Pattern *)> &callback) override {
-            for (auto i = start; i < end; i++)
-                callback(i, this->getEntry(i).get());
+            PatternCharacter entry(this->getEvaluator(), this->getOffset() + start);
+            entry.setSection(this->getSection());
+
+            for (auto i = start; i < end; i++) {
+                entry.clearFormatCache();
+                entry.clearByteCache();
+                entry.setOffset(this->getOffset() + i);
+                callback(i, &entry);
+            }
+        }
+
+        [[nodiscard]] bool hasContiguousBytes() const override {
+            return true;
         }
 
         const std::vector<u8>& getBytes() override {
             if (this->m_cachedBytes != nullptr)
                 return *this->m_cachedBytes;
 
-            std::vector<u8> result;
-
-            this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
-                auto bytes = entry->getBytes();
-                std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
-            });
-
-            this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
+            this->m_cachedBytes = std::make_unique<std::vector<u8>>(this->readBytes());
 
             return *this->m_cachedBytes;
         }
@@ -20,10 +20,18 @@ namespace pl::ptrn {
             }
         }
 
+        ~PatternStruct() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternStruct(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->m_members.capacity() * sizeof(decltype(this->m_members)::value_type) + this->m_sortedMembers.capacity() * sizeof(decltype(this->m_sortedMembers)::value_type);
+        }
+
         [[nodiscard]] std::shared_ptr<Pattern> getEntry(size_t index) const override {
             return this->m_members[index];
         }
@@ -135,7 +143,7 @@ namespace pl::ptrn {
 
             result += " }";
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
         }
 
         void setMembers(std::vector<std::shared_ptr<Pattern>> members) {
@@ -195,7 +203,11 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            return Pattern::formatDisplayValue("{ ... }", this->clone());
+            return Pattern::formatDisplayValue("{ ... }", this);
+        }
+
+        [[nodiscard]] bool hasContiguousBytes() const override {
+            return !this->isSealed() && this->areContiguous(this->m_members);
         }
 
         const std::vector<u8>& getBytes() override {
@@ -204,10 +216,14 @@ namespace pl::ptrn {
 
             std::vector<u8> result;
 
-            this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
-                auto bytes = entry->getBytes();
-                std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
-            });
+            if (this->hasContiguousBytes()) {
+                result = this->readBytes();
+            } else {
+                this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
+                    auto bytes = entry->getBytes();
+                    std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
+                });
+            }
 
             this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
 
@@ -20,10 +20,18 @@ namespace pl::ptrn {
             }
         }
 
+        ~PatternUnion() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternUnion(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage() + this->m_members.capacity() * sizeof(decltype(this->m_members)::value_type) + this->m_sortedMembers.capacity() * sizeof(decltype(this->m_sortedMembers)::value_type);
+        }
+
         [[nodiscard]] std::shared_ptr<Pattern> getEntry(size_t index) const override {
             return this->m_members[index];
         }
@@ -148,7 +156,7 @@ namespace pl::ptrn {
 
             result += " }";
 
-            return Pattern::formatDisplayValue(result, this->clone());
+            return Pattern::formatDisplayValue(result, this);
         }
 
         void sort(const std::function<bool (const Pattern *, const Pattern *)> &comparator) override {
@@ -194,18 +202,18 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            return Pattern::formatDisplayValue("{ ... }", this->clone());
+            return Pattern::formatDisplayValue("{ ... }", this);
+        }
+
+        [[nodiscard]] bool hasContiguousBytes() const override {
+            return true;
         }
 
         const std::vector<u8>& getBytes() override {
             if (this->m_cachedBytes != nullptr)
                 return *this->m_cachedBytes;
 
-            std::vector<u8> result;
-            result.resize(this->getSize());
-            this->getEvaluator()->readData(this->getOffset(), result.data(), result.size(), this->getSection());
-
-            this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
+            this->m_cachedBytes = std::make_unique<std::vector<u8>>(this->readBytes());
 
             return *this->m_cachedBytes;
         }
@@ -19,6 +19,10 @@ namespace pl::ptrn {
             return transformValue(hlp::changeEndianess(data, this->getSize(), this->getEndian()));
         }
 
+        [[nodiscard]] std::optional<hlp::ValueEncoding> getValueEncoding() const override {
+            return this->createValueEncoding(hlp::ValueEncoding::Type::Unsigned);
+        }
+
         [[nodiscard]] std::string getFormattedName() const override {
             return this->getTypeName();
         }
@@ -13,10 +13,18 @@ namespace pl::ptrn {
         PatternWideString(core::Evaluator *evaluator, u64 offset, size_t size)
             : Pattern(evaluator, offset, size) { }
 
+        ~PatternWideString() override {
+            this->measureBeforeDestruction();
+        }
+
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternWideString(*this));
         }
 
+        [[nodiscard]] size_t getMemoryUsage() const override {
+            return sizeof(*this) + this->getOwnedMemoryUsage();
+        }
+
         [[nodiscard]] core::Token::Literal getValue() const override {
             return transformValue(this->getValue(this->getSize()));
         }
@@ -91,9 +99,21 @@ namespace pl::ptrn {
             return this->getSize() / sizeof(char16_t);
         }
 
+        // All characters are visited through a single pattern that's moved from one to the next
         void forEachEntry(u64 start, u64 end, const std::function<void (u64, Pattern *)> &callback) override {
-            for (auto i = start; i < end; i++)
-                callback(i, this->getEntry(i).get());
+            PatternWideCharacter entry(this->getEvaluator(), this->getOffset() + start * sizeof(char16_t));
+            entry.setSection(this->getSection());
+
+            for (auto i = start; i < end; i++) {
+                entry.clearFormatCache();
+                entry.clearByteCache();
+                entry.setOffset(this->getOffset() + i * sizeof(char16_t));
+                callback(i, &entry);
+            }
+        }
+
+        [[nodiscard]] bool hasContiguousBytes() const override {
+            return this->getSize() % sizeof(char16_t) == 0;
         }
 
         const std::vector<u8>& getBytes() override {
@@ -102,10 +122,14 @@ namespace pl::ptrn {
 
             std::vector<u8> result;
 
-            this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
-                auto bytes = entry->getBytes();
-                std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
-            });
+            if (this->hasContiguousBytes()) {
+                result = this->readBytes();
+            } else {
+                this->forEachEntry(0, this->getEntryCount(), [&](u64, pl::ptrn::Pattern *entry) {
+                    auto bytes = entry->getBytes();
+                    std::copy(bytes.begin(), bytes.end(), std::back_inserter(result));
+                });
+            }
 
             this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
 
@@ -121,8 +121,12 @@ namespace pl::core {
             if (sectionId == ptrn::Pattern::PatternLocalSectionId) {
                 patternLocalAddress = this->m_patternLocalStorage.empty() ? 0 : this->m_patternLocalStorage.rbegin()->first + 1;
                 this->m_patternLocalStorage.insert({ patternLocalAddress, { } });
+
+                this->m_statistics.patternLocalSlotHighWaterMark = std::max<u64>(this->m_statistics.patternLocalSlotHighWaterMark, this->m_patternLocalStorage.size());
             } else if (sectionId == ptrn::Pattern::HeapSectionId) {
                 this->getHeap().emplace_back();
+
+                this->m_statistics.heapCellHighWaterMark = std::max<u64>(this->m_statistics.heapCellHighWaterMark, this->getHeap().size());
             } else {
                 err::E0001.throwError(fmt::format("Attempted to place a variable into section 0x{:X}.", sectionId), {}, type);
             }
@@ -169,6 +173,9 @@ namespace pl::core {
             if (sectionId == ptrn::Pattern::HeapSectionId) {
                 pattern->setOffset(heapAddress << 32);
                 this->getHeap()[heapAddress].resize(pattern->getSize());
+
+                if (this->m_memoryProfiler.isEnabled()) [[unlikely]]
+                    this->m_memoryProfiler.heapCellCreated(heapAddress, pattern->getSize());
             } else if (sectionId == ptrn::Pattern::PatternLocalSectionId) {
                 pattern->setOffset(u64(patternLocalAddress) << 32);
                 pattern->setSection(sectionId);
@@ -361,6 +368,9 @@ namespace pl::core {
                 pattern->setLocal(true);
                 pattern->setOffset(u64(this->getHeap().size()) << 32);
                 this->getHeap().emplace_back().resize(pattern->getSize());
+
+                if (this->m_memoryProfiler.isEnabled()) [[unlikely]]
+                    this->m_memoryProfiler.heapCellCreated(this->getHeap().size() - 1, pattern->getSize());
             }
         } else {
             this->changePatternSection(pattern, pattern->getSection());
@@ -456,7 +466,7 @@ namespace pl::core {
 
     void Evaluator::pushScope(const std::shared_ptr<ptrn::Pattern> &parent, std::vector<std::shared_ptr<ptrn::Pattern>> &scope) {
         if (this->m_scopes.size() > this->getEvaluationDepth())
-            err::E0007.throwError(fmt::format("Evaluation depth exceeded set limit of '{}'.", this->getEvaluationDepth()), "If this is intended, try increasing the limit using '#pragma eval_depth <new_limit>'.");
+            err::E0007.throwError([limit = this->getEvaluationDepth()] { return fmt::format("Evaluation depth exceeded set limit of '{}'.", limit); }, "If this is intended, try increasing the limit using '#pragma eval_depth <new_limit>'.");
 
         this->handleAbort();
 
@@ -478,6 +488,9 @@ namespace pl::core {
 
         heap.resize(currScope.heapStartSize);
 
+        if (this->m_memoryProfiler.isEnabled()) [[unlikely]]
+            this->m_memoryProfiler.heapCellsDestroyed(currScope.heapStartSize);
+
         if (this->isDebugModeEnabled())
             this->getConsole().log(LogConsole::Level::Debug, fmt::format("Exiting scope #{}. Parent: '{}', Heap Size: {}.", this->m_scopes.size(), currScope.parent == nullptr ? "None" : currScope.parent->getVariableName(), heap.size()));
 
@@ -501,11 +514,70 @@ namespace pl::core {
         return result;
     }
 
+    static std::string getTopLevelNodeName(const ast::ASTNode *node) {
+        std::string name;
+        if (auto typeDecl = dynamic_cast<const ast::ASTNodeTypeDecl*>(node); typeDecl != nullptr)
+            name = fmt::format("using {}", typeDecl->getName());
+        else if (auto functionDefinition = dynamic_cast<const ast::ASTNodeFunctionDefinition*>(node); functionDefinition != nullptr)
+            name = fmt::format("fn {}", functionDefinition->getName());
+        else if (auto varDecl = dynamic_cast<const ast::ASTNodeVariableDecl*>(node); varDecl != nullptr)
+            name = varDecl->getName();
+        else if (auto arrayVarDecl = dynamic_cast<const ast::ASTNodeArrayVariableDecl*>(node); arrayVarDecl != nullptr)
+            name = fmt::format("{}[]", arrayVarDecl->getName());
+        else if (auto pointerVarDecl = dynamic_cast<const ast::ASTNodePointerVariableDecl*>(node); pointerVarDecl != nullptr)
+            name = fmt::format("*{}", pointerVarDecl->getName());
+        else
+            name = "statement";
+
+        return name;
+    }
+
+    void Evaluator::setConcurrentAccess(bool enabled) {
+        static std::atomic<u64> nextSession = 1;
+
+        if (enabled) {
+            std::scoped_lock lock(this->m_threadArrayIndicesMutex);
+            this->m_threadArrayIndices.clear();
+            this->m_concurrentAccessSession = nextSession++;
+        }
+
+        this->m_concurrentAccess = enabled;
+    }
+
+    std::optional<u64> &Evaluator::getThreadArrayIndex() const {
+        // Remembers the slot of the evaluator this thread used last so only the first access needs to look it up
+        struct CachedSlot {
+            u64 session = 0;
+            std::optional<u64> *index = nullptr;
+        };
+        thread_local CachedSlot cachedSlot;
+
+        if (cachedSlot.session != this->m_concurrentAccessSession) [[unlikely]] {
+            std::scoped_lock lock(this->m_threadArrayIndicesMutex);
+            cachedSlot = { this->m_concurrentAccessSession, &this->m_threadArrayIndices[std::this_thread::get_id()] };
+        }
+
+        return *cachedSlot.index;
+    }
+
     void Evaluator::accessData(u64 address, void *buffer, size_t size, u64 sectionId, bool write) {
         if (size == 0 || buffer == nullptr)
             return;
 
+        // Concurrent readers only go to the data source, statistics are only collected while evaluating
+        if (this->m_concurrentAccess && !write && sectionId == ptrn::Pattern::MainSectionId) [[unlikely]] {
+            this->m_readerFunction(address, reinterpret_cast<u8*>(buffer), size);
+            return;
+        }
+
+        auto lock = this->lockSharedState();
+
+        if (write)
+            this->m_dataWriteCount++;
+
         if (sectionId == ptrn::Pattern::MainSectionId) [[likely]] {
+            this->m_statistics.mainSection.record(size, write);
+
             if (!write) [[likely]] {
                 this->m_readerFunction(address, reinterpret_cast<u8*>(buffer), size);
             } else {
@@ -513,6 +585,8 @@ namespace pl::core {
                     this->m_writerFunction(address, reinterpret_cast<u8*>(buffer), size);
             }
         } else if (sectionId == ptrn::Pattern::HeapSectionId) {
+            this->m_statistics.heapSection.record(size, write);
+
             auto &heap = this->getHeap();
 
             auto heapAddress = (address >> 32);
@@ -522,6 +596,9 @@ namespace pl::core {
 
                 if (storageAddress + size > storage.size()) {
                     storage.resize(storageAddress + size);
+
+                    if (this->m_memoryProfiler.isEnabled()) [[unlikely]]
+                        this->m_memoryProfiler.heapCellResized(heapAddress, storage.size());
                 }
 
                 if (!write)
@@ -532,6 +609,8 @@ namespace pl::core {
             else
                 err::E0011.throwError(fmt::format("Tried accessing out of bounds heap cell {}. This is a bug.", heapAddress));
         } else if (sectionId == ptrn::Pattern::PatternLocalSectionId) {
+            this->m_statistics.patternLocalSection.record(size, write);
+
             auto &patternLocal = this->m_patternLocalStorage;
 
             auto heapAddress = (address >> 32);
@@ -553,8 +632,13 @@ namespace pl::core {
         } else if (sectionId == ptrn::Pattern::InstantiationSectionId) {
             err::E0012.throwError("Cannot access data of type that hasn't been placed in memory.");
         } else {
-            if (this->m_sections.contains(sectionId)) {
-                auto &section = this->m_sections[sectionId];
+            if (auto it = this->m_sections.find(sectionId); it != this->m_sections.end()) {
+                auto &sectionStatistics = this->m_statistics.customSections;
+                if (sectionId >= sectionStatistics.size())
+                    sectionStatistics.resize(sectionId + 1);
+                sectionStatistics[sectionId].record(size, write);
+
+                auto &section = it->second;
 
                 if (!write) {
                     if ((address + size) <= section.data.size())
@@ -593,11 +677,18 @@ namespace pl::core {
         this->m_sectionId++;
 
         this->m_sections.insert({ id, { name, { } } });
+
+        if (this->m_memoryProfiler.isEnabled()) [[unlikely]]
+            this->m_memoryProfiler.sectionCreated(id);
+
         return id;
     }
 
     void Evaluator::removeSection(u64 id) {
         this->m_sections.erase(id);
+
+        if (this->m_memoryProfiler.isEnabled()) [[unlikely]]
+            this->m_memoryProfiler.sectionRemoved(id);
     }
 
     std::vector<u8>& Evaluator::getSection(u64 id) {
@@ -631,6 +722,7 @@ namespace pl::core {
         this->m_outVariables.clear();
 
         this->m_customFunctions.clear();
+        this->m_customFunctionNodes.clear();
         this->m_patterns.clear();
 
         this->m_scopes.clear();
@@ -674,6 +766,16 @@ namespace pl::core {
                     if (node == nullptr)
                         continue;
 
+                    auto span = this->m_tracer.beginSpan("declaration", [node] { return fmt::format("{} (line {})", getTopLevelNodeName(node), node->getLine()); });
+
+                    const bool profileMemory = this->m_memoryProfiler.isEnabled();
+                    if (profileMemory) [[unlikely]]
+                        this->m_memoryProfiler.pushSite(getTopLevelNodeName(node), node->getLine());
+                    ON_SCOPE_EXIT {
+                        if (profileMemory) [[unlikely]]
+                            this->m_memoryProfiler.popSite();
+                    };
+
                     auto startOffset = this->getBitwiseReadOffset();
 
                     if (dynamic_cast<ast::ASTNodeTypeDecl *>(node) != nullptr) {
@@ -769,6 +871,7 @@ namespace pl::core {
                 this->m_mainResult = mainFunction.func(this, {});
             }
         } catch (err::EvaluatorError::Exception &e) {
+            this->m_statistics.evaluationErrors++;
 
             auto node = e.getUserData();
 
@@ -791,14 +894,17 @@ namespace pl::core {
         return true;
     }
 
-    void Evaluator::updateRuntime(const ast::ASTNode *node) {
+    void Evaluator::handleBreakpoints(const ast::ASTNode *node) {
         if (this->m_evaluated)
             return;
 
-        this->handleAbort();
+        const u64 line = node->getLine();
+        const auto wordIndex = line / 64;
+        const bool isBreakpoint = wordIndex < this->m_breakpointBitmap.size() && (this->m_breakpointBitmap[wordIndex] & (u64(1) << (line % 64))) != 0;
+
+        if (isBreakpoint) {
+            this->handleAbort();
 
-        auto line = node->getLine();
-        if (this->m_breakpoints.contains(line)) {
             if (this->m_lastPauseLine != line) {
                 this->m_lastPauseLine = line;
                 this->m_breakpointHitCallback();
@@ -808,9 +914,34 @@ namespace pl::core {
         }
     }
 
-    void Evaluator::addBreakpoint(u64 line) { this->m_breakpoints.insert(line); }
-    void Evaluator::removeBreakpoint(u64 line) { this->m_breakpoints.erase(line); }
-    void Evaluator::clearBreakpoints() { this->m_breakpoints.clear(); }
+    void Evaluator::addBreakpoint(u64 line) {
+        this->m_breakpoints.insert(line);
+
+        const auto wordIndex = line / 64;
+        if (wordIndex >= this->m_breakpointBitmap.size())
+            this->m_breakpointBitmap.resize(wordIndex + 1);
+
+        this->m_breakpointBitmap[wordIndex] |= u64(1) << (line % 64);
+        this->m_hasBreakpoints = true;
+    }
+
+    void Evaluator::removeBreakpoint(u64 line) {
+        this->m_breakpoints.erase(line);
+
+        if (const auto wordIndex = line / 64; wordIndex < this->m_breakpointBitmap.size())
+            this->m_breakpointBitmap[wordIndex] &= ~(u64(1) << (line % 64));
+
+        if (this->m_breakpoints.empty())
+            this->clearBreakpoints();
+    }
+
+    void Evaluator::clearBreakpoints() {
+        this->m_breakpoints.clear();
+        this->m_breakpointBitmap.clear();
+        this->m_hasBreakpoints = false;
+        this->m_lastPauseLine.reset();
+    }
+
     void Evaluator::setBreakpointHitCallback(const std::function<void()> &callback) { this->m_breakpointHitCallback = callback; }
     const std::unordered_set<int> &Evaluator::getBreakpoints() const { return this->m_breakpoints; }
 
@@ -822,7 +953,7 @@ namespace pl::core {
         wolv::util::unused(pattern);
 
         if (this->m_currPatternCount > this->m_patternLimit && !this->m_evaluated)
-            err::E0007.throwError(fmt::format("Pattern count exceeded set limit of '{}'.", this->getPatternLimit()), "If this is intended, try increasing the limit using '#pragma pattern_limit <new_limit>'.");
+            err::E0007.throwError([limit = this->getPatternLimit()] { return fmt::format("Pattern count exceeded set limit of '{}'.", limit); }, "If this is intended, try increasing the limit using '#pragma pattern_limit <new_limit>'.");
         this->m_currPatternCount++;
 
         // Make sure we don't throw an error if we're already in an error state
@@ -0,0 +1,159 @@
+#include <pl/core/log_console.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+namespace pl::core {
+
+    void LogConsole::enableBuffering(size_t capacity, bool backgroundThread) {
+        this->disableBuffering();
+
+        {
+            std::scoped_lock lock(this->m_bufferMutex);
+            this->m_buffer.resize(std::max<size_t>(capacity, 1));
+            this->m_bufferStart = 0;
+            this->m_bufferCount = 0;
+        }
+
+        this->m_buffered = true;
+
+        if (backgroundThread) {
+            this->m_backgroundThread = std::jthread([this](std::stop_token stopToken) {
+                this->backgroundThread(stopToken);
+            });
+        }
+    }
+
+    void LogConsole::disableBuffering() {
+        if (this->m_backgroundThread.joinable()) {
+            this->m_backgroundThread.request_stop();
+            this->m_backgroundThread.join();
+        }
+
+        this->flush();
+
+        std::scoped_lock lock(this->m_bufferMutex);
+        this->m_buffered = false;
+        this->m_buffer.clear();
+        this->m_bufferStart = 0;
+        this->m_bufferCount = 0;
+    }
+
+    void LogConsole::setRateLimit(Level level, u64 messagesPerSecond) {
+        std::scoped_lock lock(this->m_bufferMutex);
+
+        this->m_rateLimits[u8(level)] = { messagesPerSecond, Clock::now(), 0, 0 };
+
+        this->m_rateLimited = std::any_of(this->m_rateLimits.begin(), this->m_rateLimits.end(), [](const RateLimit &limit) {
+            return limit.messagesPerSecond != 0;
+        });
+    }
+
+    static std::string getSuppressedMessage(u64 count) {
+        return fmt::format("{} more message(s) of this level were suppressed by the rate limit.", count);
+    }
+
+    void LogConsole::logSlow(Level level, const std::string &message) const {
+        if (this->m_rateLimited) {
+            u64 suppressed = 0;
+
+            {
+                std::scoped_lock lock(this->m_bufferMutex);
+
+                auto &limit = this->m_rateLimits[u8(level)];
+                if (limit.messagesPerSecond != 0) {
+                    const auto now = Clock::now();
+                    if (now - limit.windowStart >= std::chrono::seconds(1)) {
+                        suppressed = std::exchange(limit.suppressed, 0);
+                        limit.windowStart = now;
+                        limit.messagesInWindow = 0;
+                    }
+
+                    if (limit.messagesInWindow >= limit.messagesPerSecond) {
+                        limit.suppressed += 1;
+                        return;
+                    }
+
+                    limit.messagesInWindow += 1;
+                }
+            }
+
+            if (suppressed > 0) {
+                if (this->m_buffered)
+                    this->push(level, getSuppressedMessage(suppressed));
+                else if (this->m_logCallback)
+                    this->m_logCallback(level, getSuppressedMessage(suppressed));
+            }
+        }
+
+        if (this->m_buffered)
+            this->push(level, message);
+        else if (this->m_logCallback)
+            this->m_logCallback(level, message);
+    }
+
+    void LogConsole::push(Level level, std::string message) const {
+        std::unique_lock lock(this->m_bufferMutex);
+
+        // Without a background thread, or if it can't keep up, the logging thread delivers the messages itself
+        if (this->m_bufferCount == this->m_buffer.size()) {
+            lock.unlock();
+            this->flush();
+            lock.lock();
+        }
+
+        const auto capacity = this->m_buffer.size();
+        this->m_buffer[(this->m_bufferStart + this->m_bufferCount) % capacity] = { level, std::move(message) };
+        this->m_bufferCount += 1;
+
+        // Only wake up the background thread once when the buffer gets half full instead of on every message after that
+        if (this->m_bufferCount == std::max<size_t>(capacity / 2, 1))
+            this->m_bufferFilled.notify_one();
+    }
+
+    void LogConsole::flush() const {
+        std::scoped_lock deliveryLock(this->m_deliveryMutex);
+
+        std::vector<Entry> batch;
+        {
+            std::scoped_lock lock(this->m_bufferMutex);
+
+            batch.reserve(this->m_bufferCount);
+            for (size_t i = 0; i < this->m_bufferCount; i++)
+                batch.push_back(std::move(this->m_buffer[(this->m_bufferStart + i) % this->m_buffer.size()]));
+
+            this->m_bufferStart = 0;
+            this->m_bufferCount = 0;
+
+            for (u8 level = 0; level < this->m_rateLimits.size(); level++) {
+                if (auto suppressed = std::exchange(this->m_rateLimits[level].suppressed, 0); suppressed > 0)
+                    batch.push_back({ Level(level), getSuppressedMessage(suppressed) });
+            }
+        }
+
+        if (batch.empty())
+            return;
+
+        if (this->m_logBatchCallback) {
+            this->m_logBatchCallback(batch);
+        } else if (this->m_logCallback) {
+            for (const auto &[level, message] : batch)
+                this->m_logCallback(level, message);
+        }
+    }
+
+    void LogConsole::backgroundThread(std::stop_token stopToken) {
+        while (!stopToken.stop_requested()) {
+            {
+                std::unique_lock lock(this->m_bufferMutex);
+                this->m_bufferFilled.wait_for(lock, stopToken, std::chrono::milliseconds(100), [this] {
+                    return this->m_bufferCount >= std::max<size_t>(this->m_buffer.size() / 2, 1);
+                });
+            }
+
+            this->flush();
+        }
+    }
+
+}
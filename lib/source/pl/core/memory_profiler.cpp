@@ -0,0 +1,207 @@
+#include <pl/core/memory_profiler.hpp>
+#include <pl/patterns/pattern.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace pl::core {
+
+    void MemoryProfiler::reset() {
+        this->m_sites = { { "<top level>", 0 } };
+        this->m_siteIndices = { { this->m_sites.front(), 0 } };
+        this->m_siteStack.clear();
+
+        this->m_usages = { Usage { } };
+        this->m_highWaterMarkUsages.clear();
+
+        this->m_patterns.clear();
+        this->m_unmeasuredPatterns.clear();
+        this->m_heapCells.clear();
+        this->m_sections.clear();
+
+        this->m_liveBytes = 0;
+        this->m_highWaterMark = 0;
+        this->m_snapshotBytes = 0;
+    }
+
+    void MemoryProfiler::pushSite(const std::string &typeName, u32 line) {
+        auto key = std::make_pair(typeName.empty() ? "<anonymous>" : typeName, line);
+        auto [it, inserted] = this->m_siteIndices.insert({ key, u32(this->m_sites.size()) });
+        if (inserted) {
+            this->m_sites.push_back(std::move(key));
+            this->m_usages.emplace_back();
+        }
+
+        this->m_siteStack.push_back(it->second);
+    }
+
+    void MemoryProfiler::popSite() {
+        this->measurePatterns();
+
+        if (!this->m_siteStack.empty())
+            this->m_siteStack.pop_back();
+    }
+
+    u32 MemoryProfiler::getCurrentSite() const {
+        return this->m_siteStack.empty() ? 0 : this->m_siteStack.back();
+    }
+
+    void MemoryProfiler::updateHighWaterMark(bool forceSnapshot) {
+        if (this->m_liveBytes <= this->m_highWaterMark)
+            return;
+
+        this->m_highWaterMark = this->m_liveBytes;
+
+        // Only take a new snapshot once the peak grew noticeably to keep monotonically growing runs cheap
+        if (forceSnapshot || this->m_liveBytes - this->m_snapshotBytes >= this->m_snapshotBytes / 16) {
+            this->m_highWaterMarkUsages = this->m_usages;
+            this->m_snapshotBytes = this->m_liveBytes;
+        }
+    }
+
+    void MemoryProfiler::patternCreated(const ptrn::Pattern *pattern) {
+        const auto site = this->getCurrentSite();
+        this->m_patterns[pattern] = { site, 0, false };
+        this->m_unmeasuredPatterns.push_back(pattern);
+
+        this->m_usages[site].patternCount += 1;
+    }
+
+    void MemoryProfiler::patternDestroying(const ptrn::Pattern *pattern) {
+        auto it = this->m_patterns.find(pattern);
+        if (it == this->m_patterns.end() || it->second.measured)
+            return;
+
+        if (std::uncaught_exceptions() > 0) {
+            // The declaration that created this pattern failed. Everything it created so far is about to be destroyed, so measure
+            // it all now while it's still alive. Patterns owning others measure themselves before their members are destroyed, so
+            // none of the patterns measured here are partially destroyed
+            this->measurePatterns(true);
+        } else {
+            auto &entry = it->second;
+            entry.bytes    = pattern->getMemoryUsage();
+            entry.measured = true;
+
+            this->m_usages[entry.site].patternBytes += entry.bytes;
+            this->m_liveBytes += entry.bytes;
+            this->updateHighWaterMark();
+        }
+    }
+
+    void MemoryProfiler::patternDestroyed(const ptrn::Pattern *pattern) {
+        this->patternDestroying(pattern);
+
+        auto it = this->m_patterns.find(pattern);
+        if (it == this->m_patterns.end())
+            return;
+
+        const auto &entry = it->second;
+        auto &usage = this->m_usages[entry.site];
+        usage.patternCount -= 1;
+        usage.patternBytes -= entry.bytes;
+
+        this->m_liveBytes -= entry.bytes;
+        this->m_patterns.erase(it);
+    }
+
+    void MemoryProfiler::measurePatterns(bool forceSnapshot) {
+        for (const auto pattern : this->m_unmeasuredPatterns) {
+            // Patterns that were destroyed in the meantime aren't tracked anymore. Their address may also have been reused by a newer pattern
+            auto it = this->m_patterns.find(pattern);
+            if (it == this->m_patterns.end() || it->second.measured)
+                continue;
+
+            auto &entry = it->second;
+            entry.bytes    = pattern->getMemoryUsage();
+            entry.measured = true;
+
+            this->m_usages[entry.site].patternBytes += entry.bytes;
+            this->m_liveBytes += entry.bytes;
+        }
+
+        this->m_unmeasuredPatterns.clear();
+        this->updateHighWaterMark(forceSnapshot);
+    }
+
+    void MemoryProfiler::heapCellCreated(u64 index, u64 bytes) {
+        this->heapCellsDestroyed(index);
+
+        const auto site = this->getCurrentSite();
+        this->m_heapCells.resize(index + 1);
+        this->m_heapCells[index] = { site, bytes };
+
+        auto &usage = this->m_usages[site];
+        usage.heapCellCount += 1;
+        usage.heapBytes += bytes;
+
+        this->m_liveBytes += bytes;
+        this->updateHighWaterMark();
+    }
+
+    void MemoryProfiler::heapCellResized(u64 index, u64 bytes) {
+        if (index >= this->m_heapCells.size())
+            return;
+
+        auto &[site, oldBytes] = this->m_heapCells[index];
+        if (bytes == oldBytes)
+            return;
+
+        auto &usage = this->m_usages[site];
+        usage.heapBytes = usage.heapBytes - oldBytes + bytes;
+        this->m_liveBytes = this->m_liveBytes - oldBytes + bytes;
+        oldBytes = bytes;
+
+        this->updateHighWaterMark();
+    }
+
+    void MemoryProfiler::heapCellsDestroyed(u64 startIndex) {
+        while (this->m_heapCells.size() > startIndex) {
+            const auto [site, bytes] = this->m_heapCells.back();
+
+            auto &usage = this->m_usages[site];
+            usage.heapCellCount -= 1;
+            usage.heapBytes -= bytes;
+            this->m_liveBytes -= bytes;
+
+            this->m_heapCells.pop_back();
+        }
+    }
+
+    void MemoryProfiler::sectionCreated(u64 id) {
+        this->m_sections[id] = this->getCurrentSite();
+    }
+
+    void MemoryProfiler::sectionRemoved(u64 id) {
+        this->m_sections.erase(id);
+    }
+
+    std::vector<MemoryProfiler::Consumer> MemoryProfiler::getConsumers(const std::map<u64, api::Section> &sections, bool atHighWaterMark) const {
+        auto usages = atHighWaterMark ? this->m_highWaterMarkUsages : this->m_usages;
+
+        if (!atHighWaterMark) {
+            for (const auto &[id, site] : this->m_sections) {
+                if (auto it = sections.find(id); it != sections.end()) {
+                    usages[site].sectionCount += 1;
+                    usages[site].sectionBytes += it->second.data.size();
+                }
+            }
+        }
+
+        std::vector<Consumer> result;
+        for (size_t i = 0; i < usages.size(); i++) {
+            const auto &usage = usages[i];
+            if (usage.getTotalCount() == 0)
+                continue;
+
+            const auto &[typeName, line] = this->m_sites[i];
+            result.push_back({ typeName, line, usage });
+        }
+
+        std::sort(result.begin(), result.end(), [](const Consumer &a, const Consumer &b) {
+            return a.usage.getTotalBytes() > b.usage.getTotalBytes();
+        });
+
+        return result;
+    }
+
+}
@@ -1,4 +1,5 @@
 #include <pl/core/preprocessor.hpp>
+#include <pl/pattern_language.hpp>
 
 #include <fmt/format.h>
 
@@ -172,6 +173,8 @@ namespace pl::core {
                                     err::M0004.throwError("Path doesn't point to a valid file.");
                             }
 
+                            auto span = runtime.getTracer().beginSpan("include", [&] { return includePath.string(); });
+
                             wolv::io::File file(includePath, wolv::io::File::Mode::Read);
                             if (!file.isValid()) {
                                 err::M0005.throwError(fmt::format("Failed to open file.", *includeFile));
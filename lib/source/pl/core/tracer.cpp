@@ -0,0 +1,82 @@
+#include <pl/core/tracer.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+namespace pl::core {
+
+    void Tracer::clear() {
+        std::scoped_lock lock(this->m_mutex);
+
+        this->m_events.clear();
+        this->m_threadIds.clear();
+        this->m_epoch = Clock::now();
+    }
+
+    std::vector<Tracer::Event> Tracer::getEvents() const {
+        std::scoped_lock lock(this->m_mutex);
+
+        return this->m_events;
+    }
+
+    void Tracer::addEvent(std::string name, std::string_view category, Clock::time_point start, Clock::time_point end) {
+        std::scoped_lock lock(this->m_mutex);
+
+        const auto threadId = std::this_thread::get_id();
+        auto it = std::find(this->m_threadIds.begin(), this->m_threadIds.end(), threadId);
+        if (it == this->m_threadIds.end())
+            it = this->m_threadIds.insert(it, threadId);
+
+        this->m_events.push_back({ std::move(name), category, start, end - start, u32(std::distance(this->m_threadIds.begin(), it)) });
+    }
+
+    static std::string escapeJsonString(std::string_view string) {
+        std::string result;
+        result.reserve(string.size());
+
+        for (char c : string) {
+            switch (c) {
+                case '"':  result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n";  break;
+                case '\r': result += "\\r";  break;
+                case '\t': result += "\\t";  break;
+                default:
+                    if (u8(c) < 0x20)
+                        result += fmt::format("\\u{:04x}", u8(c));
+                    else
+                        result += c;
+                    break;
+            }
+        }
+
+        return result;
+    }
+
+    std::string Tracer::toJson() const {
+        std::scoped_lock lock(this->m_mutex);
+
+        auto toMicroseconds = [](Clock::duration duration) {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        };
+
+        std::string result = "{\"traceEvents\":[\n";
+        for (size_t i = 0; i < this->m_events.size(); i++) {
+            const auto &event = this->m_events[i];
+
+            result += fmt::format(R"({{"name":"{}","cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+                                  escapeJsonString(event.name), escapeJsonString(event.category),
+                                  toMicroseconds(event.start - this->m_epoch), toMicroseconds(event.duration),
+                                  event.threadId);
+
+            if (i + 1 < this->m_events.size())
+                result += ",";
+            result += "\n";
+        }
+        result += "],\"displayTimeUnit\":\"ms\"}\n";
+
+        return result;
+    }
+
+}
@@ -1,7 +1,12 @@
 #include <pl/helpers/utils.hpp>
 
+#include <algorithm>
 #include <codecvt>
 
+#if defined(__F16C__)
+    #include <immintrin.h>
+#endif
+
 #include <fmt/format.h>
 
 namespace pl::hlp {
@@ -92,4 +97,70 @@ namespace pl::hlp {
 
         return floatResult;
     }
+
+    namespace {
+
+        template<std::unsigned_integral T>
+        std::optional<size_t> findZeroValue(const u8 *data, size_t count) {
+            constexpr static size_t BlockSize = 256 / sizeof(T);
+            std::array<T, BlockSize> block;
+
+            for (size_t start = 0; start < count; start += BlockSize) {
+                const auto blockCount = std::min(BlockSize, count - start);
+                std::memcpy(block.data(), data + start * sizeof(T), blockCount * sizeof(T));
+
+                // Every block is checked without exiting early so the comparisons can be vectorized
+                bool found = false;
+                for (size_t i = 0; i < blockCount; i++)
+                    found |= block[i] == 0;
+
+                if (found) {
+                    for (size_t i = 0; i < blockCount; i++) {
+                        if (block[i] == 0)
+                            return start + i;
+                    }
+                }
+            }
+
+            return std::nullopt;
+        }
+
+    }
+
+    std::optional<size_t> findZeroEntry(const u8 *data, size_t count, size_t size) {
+        switch (size) {
+            case 0:
+                return count > 0 ? std::optional<size_t>(0) : std::nullopt;
+            case 1:
+                if (auto zero = static_cast<const u8 *>(std::memchr(data, 0x00, count)); zero != nullptr)
+                    return zero - data;
+                else
+                    return std::nullopt;
+            case 2: return findZeroValue<u16>(data, count);
+            case 4: return findZeroValue<u32>(data, count);
+            case 8: return findZeroValue<u64>(data, count);
+            default:
+                for (size_t i = 0; i < count; i++) {
+                    const auto entry = data + i * size;
+                    if (std::all_of(entry, entry + size, [](u8 byte) { return byte == 0x00; }))
+                        return i;
+                }
+
+                return std::nullopt;
+        }
+    }
+
+    void float16ToFloat32(const u16 *float16, float *result, size_t count) {
+        size_t i = 0;
+
+        #if defined(__F16C__)
+            for (; i + 8 <= count; i += 8) {
+                const auto halfs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(float16 + i));
+                _mm256_storeu_ps(result + i, _mm256_cvtph_ps(halfs));
+            }
+        #endif
+
+        for (; i < count; i++)
+            result[i] = float16ToFloat32(float16[i]);
+    }
 }
\ No newline at end of file
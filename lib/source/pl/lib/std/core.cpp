@@ -151,14 +151,9 @@ namespace pl::lib::libstd::core {
                 auto pattern = params[0].toPattern();
 
                 if (auto enumPattern = dynamic_cast<ptrn::PatternEnum*>(pattern.get()); enumPattern != nullptr) {
-                    auto value = enumPattern->getValue().toUnsigned();
-                    for (auto &entry : enumPattern->getEnumValues()) {
-                        auto min = entry.min.toUnsigned();
-                        auto max = entry.max.toUnsigned();
-
-                        if (value >= min && value <= max)
-                            return true;
-                    }
+                    const auto &valueTable = enumPattern->getValueTable();
+                    if (valueTable != nullptr && valueTable->find(enumPattern->getValue().toUnsigned()) != nullptr)
+                        return true;
                 }
 
                 return false;
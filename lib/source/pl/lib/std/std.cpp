@@ -11,16 +11,13 @@
 
 #include <fmt/args.h>
 
+#include <wolv/utils/guards.hpp>
+
 namespace pl::lib::libstd::libstd {
 
     namespace {
 
-        std::string format(const auto &params) {
-            using namespace pl::core;
-
-            auto format = params[0].toString(true);
-            std::string message;
-
+        std::string formatArguments(const std::string &format, const auto &params) {
             fmt::dynamic_format_arg_store<fmt::format_context> formatArgs;
 
             for (u32 i = 1; i < params.size(); i++) {
@@ -39,8 +36,61 @@ namespace pl::lib::libstd::libstd {
                 },  param);
             }
 
+            return fmt::vformat(format, formatArgs);
+        }
+
+        template<typename T>
+        void formatValue(fmt::memory_buffer &buffer, const std::string &fieldFormat, const T &value) {
+            if (fieldFormat.empty())
+                fmt::format_to(fmt::appender(buffer), "{}", value);
+            else
+                fmt::vformat_to(fmt::appender(buffer), fieldFormat, fmt::make_format_args(value));
+        }
+
+        std::string format(core::Evaluator *ctx, const auto &params) {
+            using namespace pl::core;
+
+            std::string formatCopy;
+            const std::string *format = std::get_if<std::string>(&params[0]);
+            if (format == nullptr) {
+                formatCopy = params[0].toString(true);
+                format = &formatCopy;
+            }
+
+            auto &cache = ctx->getFormatStringCache();
+            const auto formatString = cache.get(*format);
+
             try {
-                return fmt::vformat(format, formatArgs);
+                if (!formatString->isSimple())
+                    return formatArguments(*format, params);
+
+                // Pattern arguments may call formatter functions which format into the same buffer again
+                auto &buffer = cache.getBuffer();
+                const auto start = buffer.size();
+                ON_SCOPE_EXIT { buffer.resize(start); };
+
+                for (const auto &field : formatString->getFields()) {
+                    buffer.append(field.prefix);
+
+                    if (field.argumentIndex + 1 >= params.size())
+                        throw fmt::format_error("argument not found");
+
+                    std::visit(wolv::util::overloaded {
+                        [&](const std::shared_ptr<ptrn::Pattern> &value) {
+                            formatValue(buffer, field.format, value->toString());
+                        },
+                        [&](const std::string &value) {
+                            formatValue(buffer, field.format, value.c_str());
+                        },
+                        [&](auto &&value) {
+                            formatValue(buffer, field.format, value);
+                        }
+                    }, params[field.argumentIndex + 1]);
+                }
+
+                buffer.append(formatString->getSuffix());
+
+                return { buffer.data() + start, buffer.size() - start };
             } catch (fmt::format_error &error) {
                 err::E0012.throwError(fmt::format("Error while formatting: {}", error.what()));
             }
@@ -56,14 +106,14 @@ namespace pl::lib::libstd::libstd {
         {
             /* print(format, args...) */
             runtime.addFunction(nsStd, "print", FunctionParameterCount::moreThan(0), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
-                ctx->getConsole().log(LogConsole::Level::Info, format(params));
+                ctx->getConsole().log(LogConsole::Level::Info, format(ctx, params));
 
                 return std::nullopt;
             });
 
             /* format(format, args...) */
-            runtime.addFunction(nsStd, "format", FunctionParameterCount::moreThan(0), [](Evaluator *, auto params) -> std::optional<Token::Literal> {
-                return format(params);
+            runtime.addFunction(nsStd, "format", FunctionParameterCount::moreThan(0), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                return format(ctx, params);
             });
 
             /* env(name) */
@@ -44,26 +44,42 @@ namespace pl {
         this->m_running.exchange(other.m_running.load());
     }
 
+    template<typename F>
+    static auto measurePhase(core::Tracer &tracer, std::string_view name, core::Statistics::Duration &duration, F &&function) {
+        auto span = tracer.beginSpan("phase", name);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ON_SCOPE_EXIT {
+            auto endTime = std::chrono::high_resolution_clock::now();
+            duration = std::chrono::duration_cast<core::Statistics::Duration>(endTime - startTime);
+        };
+
+        return function();
+    }
+
     std::optional<std::vector<std::shared_ptr<core::ast::ASTNode>>> PatternLanguage::parseString(const std::string &code) {
-        auto preprocessedCode = this->m_internals.preprocessor->preprocess(*this, code);
+        auto &tracer  = this->m_internals.evaluator->getTracer();
+        auto &timings = this->m_internals.evaluator->getStatistics().timings;
+
+        auto preprocessedCode = measurePhase(tracer, "preprocess", timings.preprocess, [&] { return this->m_internals.preprocessor->preprocess(*this, code); });
         if (!preprocessedCode.has_value()) {
             this->m_currError = this->m_internals.preprocessor->getError();
             return std::nullopt;
         }
 
-        auto tokens = this->m_internals.lexer->lex(code, preprocessedCode.value());
+        auto tokens = measurePhase(tracer, "lex", timings.lex, [&] { return this->m_internals.lexer->lex(code, preprocessedCode.value()); });
         if (!tokens.has_value()) {
             this->m_currError = this->m_internals.lexer->getError();
             return std::nullopt;
         }
 
-        auto ast = this->m_internals.parser->parse(code, tokens.value());
+        auto ast = measurePhase(tracer, "parse", timings.parse, [&] { return this->m_internals.parser->parse(code, tokens.value()); });
         if (!ast.has_value()) {
             this->m_currError = this->m_internals.parser->getError();
             return std::nullopt;
         }
 
-        if (!this->m_internals.validator->validate(code, *ast, true, true)) {
+        if (!measurePhase(tracer, "validate", timings.validate, [&] { return this->m_internals.validator->validate(code, *ast, true, true); })) {
             this->m_currError = this->m_internals.validator->getError();
 
             return std::nullopt;
@@ -97,6 +113,8 @@ namespace pl {
 
             for (const auto &cleanupCallback : this->m_cleanupCallbacks)
                 cleanupCallback(*this);
+
+            evaluator->getConsole().flush();
         };
 
         this->reset();
@@ -113,7 +131,7 @@ namespace pl {
 
         evaluator->setReadOffset(this->m_startAddress.value_or(evaluator->getDataBaseAddress()));
 
-        if (!evaluator->evaluate(code, this->m_currAST)) {
+        if (!measurePhase(evaluator->getTracer(), "evaluate", evaluator->getStatistics().timings.evaluate, [&] { return evaluator->evaluate(code, this->m_currAST); })) {
             this->m_currError = evaluator->getConsole().getLastHardError();
             return false;
         }
@@ -131,7 +149,7 @@ namespace pl {
             this->m_patterns[pattern->getSection()].push_back(pattern);
         this->m_patterns.erase(ptrn::Pattern::HeapSectionId);
 
-        this->flattenPatterns();
+        measurePhase(evaluator->getTracer(), "flatten", evaluator->getStatistics().timings.flatten, [this] { this->flattenPatterns(); });
 
         if (this->m_aborted) {
             this->reset();
@@ -214,6 +232,23 @@ namespace pl {
         this->m_internals.evaluator->getConsole().setLogCallback(callback);
     }
 
+    void PatternLanguage::setLogBatchCallback(const core::LogConsole::BatchCallback &callback) {
+        this->m_internals.evaluator->getConsole().setLogBatchCallback(callback);
+    }
+
+    void PatternLanguage::setLogBuffering(size_t capacity, bool backgroundThread) {
+        auto &console = this->m_internals.evaluator->getConsole();
+
+        if (capacity == 0)
+            console.disableBuffering();
+        else
+            console.enableBuffering(capacity, backgroundThread);
+    }
+
+    void PatternLanguage::setLogRateLimit(core::LogConsole::Level level, u64 messagesPerSecond) {
+        this->m_internals.evaluator->getConsole().setRateLimit(level, messagesPerSecond);
+    }
+
     const std::optional<core::err::PatternLanguageError> &PatternLanguage::getError() const {
         return this->m_currError;
     }
@@ -226,6 +261,29 @@ namespace pl {
         return this->m_internals.evaluator->getPatternLimit();
     }
 
+    const core::Statistics& PatternLanguage::getStatistics() const {
+        return this->m_internals.evaluator->getStatistics();
+    }
+
+    void PatternLanguage::setTracingEnabled(bool enabled) {
+        this->m_internals.evaluator->getTracer().setEnabled(enabled);
+    }
+
+    core::Tracer& PatternLanguage::getTracer() const {
+        return this->m_internals.evaluator->getTracer();
+    }
+
+    void PatternLanguage::setMemoryProfilingEnabled(bool enabled) {
+        this->m_internals.evaluator->getMemoryProfiler().setEnabled(enabled);
+    }
+
+    std::vector<core::MemoryProfiler::Consumer> PatternLanguage::getMemoryConsumers(bool atHighWaterMark) const {
+        const auto &evaluator = this->m_internals.evaluator;
+
+        evaluator->getMemoryProfiler().measurePatterns();
+        return evaluator->getMemoryProfiler().getConsumers(evaluator->getSections(), atHighWaterMark);
+    }
+
     const std::vector<u8>& PatternLanguage::getSection(u64 id) const {
         static std::vector<u8> empty;
         if (id > this->m_internals.evaluator->getSectionCount() || id == ptrn::Pattern::MainSectionId || id == ptrn::Pattern::HeapSectionId)
@@ -254,6 +312,10 @@ namespace pl {
         this->m_currError.reset();
         this->m_internals.validator->setRecursionDepth(32);
 
+        this->m_internals.evaluator->getStatistics() = { };
+        this->m_internals.evaluator->getTracer().clear();
+        this->m_internals.evaluator->getMemoryProfiler().reset();
+
         this->m_internals.evaluator->getConsole().clear();
         this->m_internals.evaluator->setDefaultEndian(this->m_defaultEndian);
         this->m_internals.evaluator->setEvaluationDepth(32);
@@ -288,7 +350,7 @@ namespace pl {
     void PatternLanguage::flattenPatterns() {
 
         for (const auto &[section, patterns] : this->m_patterns) {
-            auto &sectionTree = this->m_flattenedPatterns[section];
+            std::vector<hlp::StaticIntervalIndex<ptrn::Pattern*>::Element> intervals;
             for (const auto &pattern : patterns) {
                 auto children = pattern->getChildren();
 
@@ -299,9 +361,11 @@ namespace pl {
                     if (child->getSize() == 0)
                         continue;
 
-                    sectionTree.insert({ address, address + child->getSize() - 1 }, child);
+                    intervals.push_back({ { address, address + child->getSize() - 1 }, child });
                 }
             }
+
+            this->m_flattenedPatterns[section] = hlp::StaticIntervalIndex<ptrn::Pattern*>(std::move(intervals));
         }
     }
 
@@ -324,4 +388,18 @@ namespace pl {
         return results;
     }
 
+    std::vector<api::PatternRange> PatternLanguage::getPatternsInRange(u64 start, u64 end, u64 section) const {
+        auto tree = this->m_flattenedPatterns.find(section);
+        if (tree == this->m_flattenedPatterns.end() || start > end)
+            return { };
+
+        // The index already reports the patterns sorted by their start address
+        std::vector<api::PatternRange> results;
+        tree->second.forEachOverlapping({ start, end }, [&](const auto &interval, ptrn::Pattern *pattern) {
+            results.push_back({ std::max(interval.start, start), std::min(interval.end, end), interval.start, pattern });
+        });
+
+        return results;
+    }
+
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 
+#include <pl/pattern_language.hpp>
 #include <pl/patterns/pattern.hpp>
 
 #define TEST(name) (pl::test::TestPattern *)new pl::test::TestPattern##name()
@@ -49,12 +50,24 @@ namespace pl::test {
             return TestPattern::s_tests;
         }
 
+        // Called before the source code gets executed
+        virtual void setup(PatternLanguage &runtime) const {
+            wolv::util::unused(runtime);
+        }
+
         [[nodiscard]] virtual bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const {
             wolv::util::unused(patterns);
 
             return true;
         }
 
+        // Called instead of runChecks when a failing test failed as expected
+        [[nodiscard]] virtual bool runFailureChecks(const PatternLanguage &runtime) const {
+            wolv::util::unused(runtime);
+
+            return true;
+        }
+
     private:
         std::vector<std::unique_ptr<ptrn::Pattern>> m_patterns;
         Mode m_mode;
@@ -57,4 +57,138 @@ namespace pl::test {
         }
     };
 
-}
\ No newline at end of file
+    class TestPatternWhileArrays : public TestPattern {
+    public:
+        TestPatternWhileArrays() : TestPattern("WhileArrays") {
+        }
+        ~TestPatternWhileArrays() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                namespace std::mem {
+                    enum Endian : u8 { Native = 0, Big = 1, Little = 2 };
+
+                    fn read_unsigned(u128 address, u8 size, Endian endian = Endian::Native) {
+                        return builtin::std::mem::read_unsigned(address, size, u32(endian));
+                    };
+                }
+
+                // Interpreted version of the read_unsigned terminated arrays below
+                fn count_until(u128 start, u128 step, u128 size, u128 terminator) {
+                    u128 address = start;
+                    while (builtin::std::mem::read_unsigned(address, size, 1) != terminator)
+                        address += step;
+                    return (address - start) / step;
+                };
+
+                u128 limit = 0x28;
+                u8 below[while($ < 0x30)] @ 0x10;
+                u8 belowVariable[while($ < limit)] @ 0x08;
+                u8 belowBoth[while($ < limit && $ < 0x40)] @ 0x00;
+
+                u8 untilIDAT[while(std::mem::read_unsigned($, 4, std::mem::Endian::Big) != 0x49444154)] @ 0x00;
+                u8 untilIDATNative[while(std::mem::read_unsigned($, 4) != 0x54414449)] @ 0x00;
+                u8 untilIDATBuiltin[while(builtin::std::mem::read_unsigned($ + 1, 2, 1) != 0x4441)] @ 0x00;
+                u16 wordsUntilChunk[while(std::mem::read_unsigned($ + 2, 2, std::mem::Endian::Big) != 0x4944)] @ 0x15;
+
+                u8 untilT[while($[$ + 2] != 0x54)] @ 0x20;
+                u8 notUntilT[while(!($[$ + 2] == 0x54))] @ 0x20;
+
+                u8 tail[while(std::mem::read_unsigned($, 4, std::mem::Endian::Big) != 0)] @ 0x291DB;
+
+                std::assert(sizeof(below) == 0x20, "$ < constant invalid");
+                std::assert(sizeof(belowVariable) == 0x20, "$ < variable invalid");
+                std::assert(sizeof(belowBoth) == 0x28, "$ < variable && $ < constant invalid");
+                std::assert(sizeof(untilIDAT) == 0x25, "std::mem::read_unsigned terminator invalid");
+                std::assert(sizeof(untilIDAT) == count_until(0x00, 1, 4, 0x49444154), "std::mem::read_unsigned terminator doesn't match interpreter");
+                std::assert(sizeof(untilIDATNative) == 0x25, "std::mem::read_unsigned terminator with default endian invalid");
+                std::assert(sizeof(untilIDATBuiltin) == 0x25, "builtin::std::mem::read_unsigned terminator invalid");
+                std::assert(sizeof(wordsUntilChunk) / 2 == count_until(0x17, 2, 2, 0x4944), "read_unsigned terminator of u16 array invalid");
+                std::assert(sizeof(untilT) == 6, "$[$ + n] terminator invalid");
+                std::assert(sizeof(notUntilT) == 6, "Negated $[$ + n] terminator invalid");
+                std::assert(sizeof(tail) == 8, "read_unsigned terminator at the end of the data invalid");
+                std::assert(sizeof(tail) == count_until(0x291DB, 1, 4, 0), "read_unsigned terminator at the end of the data doesn't match interpreter");
+            )";
+        }
+    };
+
+    class TestPatternWhileArraysFallback : public TestPattern {
+    public:
+        TestPatternWhileArraysFallback() : TestPattern("WhileArraysFallback") {
+        }
+        ~TestPatternWhileArraysFallback() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                namespace std::mem {
+                    enum Endian : u8 { Native = 0, Big = 1, Little = 2 };
+
+                    // Doesn't simply forward to the builtin so conditions using it have to be interpreted
+                    fn read_unsigned(u128 address, u8 size, Endian endian = Endian::Native) {
+                        return builtin::std::mem::read_unsigned(address + 1, size, u32(endian));
+                    };
+                }
+
+                u8 untilIDAT[while(std::mem::read_unsigned($, 4, std::mem::Endian::Big) != 0x49444154)] @ 0x00;
+                u8 modulo[while($ % 0x10 != 0x0C)] @ 0x01;
+
+                std::assert(sizeof(untilIDAT) == 0x24, "Custom read_unsigned was not interpreted");
+                std::assert(sizeof(modulo) == 0x0B, "Condition with arithmetic on $ was not interpreted");
+            )";
+        }
+    };
+
+    class TestPatternNullTerminatedArrays : public TestPattern {
+    public:
+        TestPatternNullTerminatedArrays() : TestPattern("NullTerminatedArrays") {
+        }
+        ~TestPatternNullTerminatedArrays() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                #pragma array_limit 0
+                #pragma loop_limit 0
+
+                // Interpreted version of the null entry search, the null entry itself is part of the array
+                fn count_entries(u128 start, u128 size) {
+                    u128 address = start;
+                    while (builtin::std::mem::read_unsigned(address, size, 2) != 0)
+                        address += size;
+                    return (address - start) / size + 1;
+                };
+
+                u8 bytes[] @ 0x101;
+                u16 words[] @ 0x11;
+                u16 manyWords[] @ 0x24;
+                u24 triples[] @ 0x00;
+                u32 dwords[] @ 0x03;
+                u8 firstIsNull[] @ 0x10;
+
+                std::assert(sizeof(bytes) == 833, "Null terminated u8 array invalid");
+                std::assert(sizeof(bytes) == count_entries(0x101, 1), "Null terminated u8 array doesn't match interpreter");
+                std::assert(sizeof(words) / 2 == 6, "Null terminated u16 array at an odd address invalid");
+                std::assert(sizeof(manyWords) / 2 == 84187, "Null terminated u16 array spanning many chunks invalid");
+                std::assert(sizeof(triples) / 3 == 56137, "Null terminated u24 array invalid");
+                std::assert(sizeof(dwords) / 4 == 42102, "Null terminated u32 array ending close to the end of the data invalid");
+                std::assert(sizeof(firstIsNull) == 1, "Null terminated array starting with a null entry invalid");
+            )";
+        }
+    };
+
+    class TestPatternNullTerminatedArraysPastEnd : public TestPattern {
+    public:
+        TestPatternNullTerminatedArraysPastEnd() : TestPattern("NullTerminatedArraysPastEnd", Mode::Failing) {
+        }
+        ~TestPatternNullTerminatedArraysPastEnd() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                #pragma array_limit 0
+
+                // There's no null entry before the end of the data
+                u64 values[] @ 0x00;
+            )";
+        }
+    };
+
+}
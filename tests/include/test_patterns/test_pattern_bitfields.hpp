@@ -4,6 +4,9 @@
 
 #include <pl/patterns/pattern_bitfield.hpp>
 
+#include <cstring>
+#include <memory>
+
 namespace pl::test {
 
     class TestPatternBitfields : public TestPattern {
@@ -163,4 +166,109 @@ namespace pl::test {
         }
     };
 
-}
\ No newline at end of file
+    class TestPatternBitfieldCaches : public TestPattern {
+    public:
+        TestPatternBitfieldCaches() : TestPattern("BitfieldCaches") {
+        }
+        ~TestPatternBitfieldCaches() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                bitfield Flags {
+                    a : 3;
+                    b : 5;
+                } [[static]];
+
+                bitfield Nested {
+                    Flags inner;
+                    c : 4;
+                    Flags array[2];
+                    d : 4;
+                };
+
+                Flags flags[8] @ 0x25;
+                be Flags bigFlags[8] @ 0x2D;
+                be Nested nested @ 0x35;
+                Nested littleNested @ 0x39;
+                Flags writable @ 0x3D;
+            )";
+        }
+
+        // Every field has to have the same value as when its bits are read straight from the data
+        [[nodiscard]] static bool checkFields(ptrn::Pattern *pattern) {
+            if (auto field = dynamic_cast<ptrn::PatternBitfieldField *>(pattern); field != nullptr) {
+                const auto expected = field->getEvaluator()->readBits(field->getOffset(), field->getBitOffset(), field->getBitSize(), field->getSection(), field->getEndian());
+
+                return field->getValue().toUnsigned() == expected;
+            }
+
+            bool result = true;
+            if (auto iterable = dynamic_cast<ptrn::IIterable *>(pattern); iterable != nullptr) {
+                iterable->forEachEntry(0, iterable->getEntryCount(), [&](u64, ptrn::Pattern *entry) {
+                    result = result && checkFields(entry);
+                });
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] static ptrn::Pattern *findMember(ptrn::Pattern *pattern, const std::string &name) {
+            ptrn::Pattern *result = nullptr;
+            if (auto iterable = dynamic_cast<ptrn::IIterable *>(pattern); iterable != nullptr) {
+                iterable->forEachEntry(0, iterable->getEntryCount(), [&](u64, ptrn::Pattern *entry) {
+                    if (result == nullptr && entry->getVariableName() == name)
+                        result = entry;
+                });
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            if (patterns.size() != 5)
+                return false;
+
+            for (const auto &pattern : patterns) {
+                (void)pattern->getFormattedValue();
+                if (!checkFields(pattern.get()))
+                    return false;
+            }
+
+            // Replace the data behind the evaluator's back the same way a host editing its data would
+            auto evaluator = patterns.front()->getEvaluator();
+            auto data = std::make_shared<std::vector<u8>>(evaluator->getDataSize());
+            evaluator->readData(evaluator->getDataBaseAddress(), data->data(), data->size(), ptrn::Pattern::MainSectionId);
+            for (auto &byte : *data)
+                byte = ~byte;
+
+            evaluator->setDataSource(evaluator->getDataBaseAddress(), data->size(),
+                [data](u64 offset, u8 *buffer, size_t size) {
+                    std::memcpy(buffer, data->data() + offset, size);
+                },
+                [data](u64 offset, const u8 *buffer, size_t size) {
+                    std::memcpy(data->data() + offset, buffer, size);
+                }
+            );
+
+            for (const auto &pattern : patterns) {
+                pattern->clearFormatCache();
+                if (!checkFields(pattern.get()))
+                    return false;
+            }
+
+            // Writes to a field have to show up in the field itself and its neighbours
+            auto writable = patterns.back().get();
+            auto a = findMember(writable, "a"), b = findMember(writable, "b");
+            if (a == nullptr || b == nullptr)
+                return false;
+
+            const auto previousA = a->getValue().toUnsigned();
+            b->setValue(u128(0x15));
+            if (b->getValue().toUnsigned() != 0x15 || a->getValue().toUnsigned() != previousA || !checkFields(writable))
+                return false;
+
+            return true;
+        }
+    };
+
+}
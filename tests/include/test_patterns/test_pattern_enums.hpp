@@ -4,6 +4,8 @@
 
 #include <pl/patterns/pattern_enum.hpp>
 
+#include <map>
+
 namespace pl::test {
 
     class TestPatternEnums : public TestPattern {
@@ -40,4 +42,93 @@ namespace pl::test {
         }
     };
 
-}
\ No newline at end of file
+    class TestPatternEnumRanges : public TestPattern {
+    public:
+        TestPatternEnumRanges() : TestPattern("EnumRanges") {
+        }
+        ~TestPatternEnumRanges() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                enum Overlapping : u8 {
+                    Wide        = 0x00 ... 0x7F,
+                    Inner       = 0x40 ... 0x4F,
+                    Straddle    = 0x70 ... 0x90,
+                    Single      = 0x89,
+                    High        = 0xA0 ... 0xFF
+                };
+
+                enum Negative : s8 {
+                    Minus       = -128 ... -2,
+                    MinusOne    = -1,
+                    Zero        = 0,
+                    Positive    = 1 ... 127
+                };
+
+                enum Sparse : s32 {
+                    Low         = -0x10000000 ... -0x100,
+                    Crossing    = -0x10 ... 0x10,
+                    Small       = 0x04 ... 0x08,
+                    Far         = 0x10000000 ... 0x20000000
+                };
+
+                Overlapping single @ 0x00;
+                Overlapping wide @ 0x01;
+                Overlapping inner @ 0x1E;
+                Overlapping missing @ 0x31;
+
+                Negative negative @ 0x00;
+                Negative allOnes @ 0x32;
+                Negative zero @ 0x08;
+                Negative positive @ 0x01;
+
+                Sparse low @ 0x2F;
+                Sparse small @ 0x19;
+                Sparse far @ 0x03;
+                Sparse beyond @ 0x30;
+            )";
+        }
+
+        // Enum entries are ordered by their name, overlapping ranges resolve to the first of them that contains the value.
+        // Values are read unsigned and compared against the entries as u128, negative entries lie at the very top of that range
+        // and ranges crossing zero are empty
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            const std::map<std::string, std::string> expectedNames = {
+                { "single",     "Overlapping::Single" },
+                { "wide",       "Overlapping::Wide" },
+                { "inner",      "Overlapping::Inner" },
+                { "missing",    "Overlapping::???" },
+                { "negative",   "Negative::???" },
+                { "allOnes",    "Negative::???" },
+                { "zero",       "Negative::Zero" },
+                { "positive",   "Negative::Positive" },
+                { "low",        "Sparse::???" },
+                { "small",      "Sparse::Small" },
+                { "far",        "Sparse::Far" },
+                { "beyond",     "Sparse::???" },
+            };
+
+            if (patterns.size() != expectedNames.size())
+                return false;
+
+            for (const auto &pattern : patterns) {
+                auto enumPattern = dynamic_cast<ptrn::PatternEnum *>(pattern.get());
+                if (enumPattern == nullptr || enumPattern->getValueTable() == nullptr)
+                    return false;
+
+                if (pattern->toString() != expectedNames.at(pattern->getVariableName()))
+                    return false;
+
+                // The table has to resolve every value to the first entry containing it, like a linear search over the entries does
+                const auto &values = enumPattern->getEnumValues();
+                for (i128 value = -0x200; value <= 0x200; value++) {
+                    if (ptrn::PatternEnum::getEnumName("Test", u128(value), enumPattern->getValueTable().get()) != ptrn::PatternEnum::getEnumName("Test", u128(value), values))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -5,6 +5,10 @@
 #include <pl/patterns/pattern_struct.hpp>
 #include <pl/patterns/pattern_unsigned.hpp>
 
+#include <pl/pattern_language.hpp>
+
+#include <array>
+
 namespace pl::test {
 
     class TestPatternMatching : public TestPattern {
@@ -42,4 +46,94 @@ namespace pl::test {
         }
     };
 
-}
\ No newline at end of file
+    class TestPatternAmbiguousMatches : public TestPattern {
+    public:
+        TestPatternAmbiguousMatches() : TestPattern("AmbiguousMatches") {
+        }
+        ~TestPatternAmbiguousMatches() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Overlapping {
+                    u8 value;
+                    match (value) {
+                        (0x00 ... 0x4F): u8 low;
+                        (0x40 ... 0x8F | 0x95): u8 middle;
+                        (0x89 ... 0xFF): u8 high;
+                    }
+                };
+
+                struct Negative {
+                    s8 value;
+                    match (value) {
+                        (-128 ... -0x78): u8 low;
+                        (-0x76 ... 0): u8 high;
+                        (_): u8 other;
+                    }
+                };
+
+                Overlapping low @ 0x08;
+                Overlapping middle @ 0x01;
+                Overlapping high @ 0x32;
+                Negative gap @ 0x00;
+                Negative minusOne @ 0x32;
+
+                std::assert(sizeof(low.low) == 1, "Wrong case matched");
+                std::assert(sizeof(middle.middle) == 1, "Wrong case matched");
+                std::assert(sizeof(high.high) == 1, "Wrong case matched");
+                std::assert(sizeof(gap.other) == 1, "Wrong case matched");
+                std::assert(sizeof(minusOne.high) == 1, "Wrong case matched");
+            )";
+        }
+
+        // Ambiguous matches have to report the same two cases, no matter if the cases are looked up in the jump table or evaluated one after the other
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &) const override {
+            constexpr static auto Source = R"(
+                struct Test {{
+                    {} value;
+                    match (value) {{
+                        {}
+                    }}
+                }};
+
+                Test test @ 0x00;
+            )";
+
+            struct AmbiguousMatch {
+                std::string type, cases;
+                u32 first, second;
+            };
+
+            const std::array matches = {
+                AmbiguousMatch { "u8", "(0x00 ... 0x4F): u8 a; (0x40 ... 0x8F): u8 b; (0x89 ... 0xFF): u8 c;", 2, 3 },
+                AmbiguousMatch { "u8", "(0x80 ... 0x90): u8 a; (0x00 ... 0x7F): u8 b; (0x89): u8 c;", 1, 3 },
+                AmbiguousMatch { "u8", "(0x10 | 0x89): u8 a; (0x80 ... 0x90): u8 b; (0x89 | 0x20): u8 c;", 1, 2 },
+                AmbiguousMatch { "s8", "(-1): u8 a; (-0x77): u8 b; (0 ... 0x7F): u8 c; (-128 ... 0): u8 d;", 2, 4 },
+                AmbiguousMatch { "be u16", "(0x8950 ... 0x9000): u8 a; (0x0000 ... 0x00FF): u8 b; (0x8950): u8 c;", 1, 3 },
+            };
+
+            const std::array<u8, 2> data = { 0x89, 0x50 };
+            for (const auto &match : matches) {
+                std::vector<std::string> errors;
+                for (const auto pragma : { "\n", "#pragma debug\n" }) {
+                    pl::PatternLanguage runtime;
+                    runtime.setDataSource(0x00, data.size(), [&data](u64 offset, u8 *buffer, size_t size) {
+                        std::copy_n(data.begin() + offset, size, buffer);
+                    });
+
+                    if (runtime.executeString(pragma + fmt::format(Source, match.type, match.cases)) || !runtime.getError().has_value())
+                        return false;
+
+                    errors.push_back(runtime.getError()->message);
+                }
+
+                const auto expected = fmt::format("Match is ambiguous. Both case {} and {} match.", match.first, match.second);
+                if (errors[0] != errors[1] || !errors[0].contains(expected))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace pl::test {
+
+    class TestPatternMemoryProfileLimit : public TestPattern {
+    public:
+        TestPatternMemoryProfileLimit() : TestPattern("MemoryProfileLimit", Mode::Failing) {
+        }
+        ~TestPatternMemoryProfileLimit() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                #pragma pattern_limit 20
+
+                struct A { u8 x; u8 y; };
+                A a[30] @ 0;
+            )";
+        }
+
+        void setup(PatternLanguage &runtime) const override {
+            runtime.setMemoryProfilingEnabled(true);
+        }
+
+        [[nodiscard]] bool runFailureChecks(const PatternLanguage &runtime) const override {
+            // The pattern that exceeded the limit must not be tracked anymore
+            return runtime.getMemoryConsumers().empty();
+        }
+    };
+
+    class TestPatternMemoryProfileFailedDecl : public TestPattern {
+    public:
+        TestPatternMemoryProfileFailedDecl() : TestPattern("MemoryProfileFailedDecl", Mode::Failing) {
+        }
+        ~TestPatternMemoryProfileFailedDecl() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                #pragma pattern_limit 20
+
+                struct A {
+                    u8 a; u8 b; u8 c; u8 d; u8 e; u8 f; u8 g; u8 h; u8 i; u8 j; u8 k; u8 l;
+                    u8 m; u8 n; u8 o; u8 p; u8 q; u8 r; u8 s; u8 t; u8 u; u8 v; u8 w; u8 x;
+                };
+
+                A a @ 0;
+            )";
+        }
+
+        void setup(PatternLanguage &runtime) const override {
+            runtime.setMemoryProfilingEnabled(true);
+        }
+
+        [[nodiscard]] bool runFailureChecks(const PatternLanguage &runtime) const override {
+            // The struct and the 20 members created before the limit was hit were never measured before getting destroyed again
+            for (const auto &consumer : runtime.getMemoryConsumers(true)) {
+                if (consumer.typeName == "A")
+                    return consumer.usage.patternCount == 21 && consumer.usage.patternBytes >= 21 * sizeof(ptrn::Pattern);
+            }
+
+            return false;
+        }
+    };
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/patterns/pattern_character.hpp>
+#include <pl/patterns/pattern_string.hpp>
+#include <pl/patterns/pattern_wide_character.hpp>
+#include <pl/patterns/pattern_wide_string.hpp>
+
+namespace pl::test {
+
+    class TestPatternStrings : public TestPattern {
+    public:
+        TestPatternStrings() : TestPattern("Strings") {
+        }
+        ~TestPatternStrings() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"test(
+                char magic[4] @ 0x00;
+                char16 wideMagic[4] @ 0x00;
+                be char16 bigWideMagic[4] @ 0x08;
+
+                std::assert(magic == "\x89PNG", "String value not correct");
+                std::assert(sizeof(wideMagic) == 8, "Wide string size not correct");
+            )test";
+        }
+
+        // Entries of strings are a single character pattern that's moved from one character to the next.
+        // Every entry has to show its own value instead of anything cached for a previous one
+        template<typename String, typename Character>
+        [[nodiscard]] static bool checkEntries(ptrn::Pattern *pattern) {
+            auto string = dynamic_cast<String *>(pattern);
+            if (string == nullptr || string->getEntryCount() != 4)
+                return false;
+
+            bool result = true;
+            string->forEachEntry(0, string->getEntryCount(), [&](u64, ptrn::Pattern *entry) {
+                Character character(entry->getEvaluator(), entry->getOffset());
+                character.setSection(entry->getSection());
+                character.setEndian(entry->getEndian());
+
+                if (entry->getFormattedValue() != character.getFormattedValue() || entry->getBytes() != character.getBytes())
+                    result = false;
+            });
+
+            return result;
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            for (const auto &pattern : patterns) {
+                auto varName = pattern->getVariableName();
+
+                if (varName == "magic") {
+                    if (!checkEntries<ptrn::PatternString, ptrn::PatternCharacter>(pattern.get()))
+                        return false;
+
+                    std::vector<std::string> values;
+                    dynamic_cast<ptrn::PatternString *>(pattern.get())->forEachEntry(1, 4, [&](u64, ptrn::Pattern *entry) {
+                        values.push_back(entry->getFormattedValue());
+                    });
+
+                    if (values != std::vector<std::string>{ "'P'", "'N'", "'G'" })
+                        return false;
+                } else if (varName == "wideMagic") {
+                    if (!checkEntries<ptrn::PatternWideString, ptrn::PatternWideCharacter>(pattern.get()))
+                        return false;
+                } else if (varName == "bigWideMagic") {
+                    if (!checkEntries<ptrn::PatternWideString, ptrn::PatternWideCharacter>(pattern.get()))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+    };
+
+}
@@ -41,4 +41,109 @@ namespace pl::test {
         }
     };
 
-}
\ No newline at end of file
+    class TestPatternStructBytes : public TestPattern {
+    public:
+        TestPatternStructBytes() : TestPattern("StructBytes") {
+        }
+        ~TestPatternStructBytes() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                fn double_value(u16 value) {
+                    return value * 2;
+                };
+
+                struct Padded {
+                    u8 a;
+                    padding[2];
+                    u8 b;
+                };
+
+                struct Gap {
+                    u8 a;
+                    u8 b @ 0x06;
+                };
+
+                struct Sealed {
+                    u16 x;
+                    u16 y;
+                } [[sealed]];
+
+                struct Transformed {
+                    u16 value [[transform("double_value")]];
+                    u16 raw;
+                };
+
+                struct Outer {
+                    Padded padded;
+                    Sealed sealed;
+                    Transformed transformed;
+                    u8 values[4];
+                };
+
+                Padded padded @ 0x00;
+                Gap gap @ 0x00;
+                Sealed sealed @ 0x08;
+                Transformed transformed @ 0x0C;
+                Outer outer @ 0x00;
+                Outer outers[3] @ 0x10;
+                Padded paddedArray[4] @ 0x40;
+            )";
+        }
+
+        // The bytes of a pattern are the bytes of all of its values in order, no matter how they're read
+        [[nodiscard]] static std::vector<u8> getValueBytes(ptrn::Pattern *pattern) {
+            auto iterable = dynamic_cast<ptrn::IIterable *>(pattern);
+            if (iterable == nullptr || iterable->getEntryCount() == 0)
+                return pattern->getBytes();
+
+            std::vector<u8> result;
+            iterable->forEachEntry(0, iterable->getEntryCount(), [&](u64, ptrn::Pattern *entry) {
+                auto bytes = getValueBytes(entry);
+                result.insert(result.end(), bytes.begin(), bytes.end());
+            });
+
+            return result;
+        }
+
+        [[nodiscard]] static std::vector<u8> readData(ptrn::Pattern *pattern) {
+            std::vector<u8> result(pattern->getSize());
+            pattern->getEvaluator()->readData(pattern->getOffset(), result.data(), result.size(), pattern->getSection());
+
+            return result;
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            for (const auto &pattern : patterns) {
+                if (pattern->getBytes() != getValueBytes(pattern.get()))
+                    return false;
+
+                auto varName = pattern->getVariableName();
+
+                if (varName == "padded") {
+                    if (!pattern->hasContiguousBytes() || pattern->getBytes() != std::vector<u8>{ 0x89, 0x50, 0x4E, 0x47 })
+                        return false;
+                } else if (varName == "gap") {
+                    if (pattern->hasContiguousBytes() || pattern->getBytes() != std::vector<u8>{ 0x89, 0x1A })
+                        return false;
+                } else if (varName == "sealed") {
+                    // Sealed structs don't expose the bytes of their members
+                    if (pattern->hasContiguousBytes() || !pattern->getBytes().empty())
+                        return false;
+                } else if (varName == "transformed") {
+                    if (pattern->hasContiguousBytes() || pattern->getBytes() != std::vector<u8>{ 0x92, 0x90, 0x44, 0x52 })
+                        return false;
+                } else if (varName == "outer" || varName == "outers") {
+                    if (pattern->hasContiguousBytes())
+                        return false;
+                } else if (varName == "paddedArray") {
+                    if (!pattern->hasContiguousBytes() || pattern->getBytes() != readData(pattern.get()))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+}
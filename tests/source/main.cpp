@@ -60,6 +60,7 @@ int runTests(int argc, char **argv) {
     });
 
     auto &test = testPatterns[testName];
+    test->setup(runtime);
 
     auto result = runtime.executeString(test->getSourceCode());
 
@@ -70,6 +71,11 @@ int runTests(int argc, char **argv) {
         if (auto error = runtime.getError(); error.has_value())
             fmt::print("Compile error: {}:{} : {}\n", error->line, error->column, error->message);
 
+        if (failing && !test->runFailureChecks(runtime)) {
+            fmt::print("Post-failure checks failed!\n");
+            return EXIT_FAILURE;
+        }
+
         return failing ? EXIT_SUCCESS : EXIT_FAILURE;
     }
 
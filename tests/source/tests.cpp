@@ -19,26 +19,39 @@
 #include "test_patterns/test_pattern_nested_structs.hpp"
 #include "test_patterns/test_pattern_attributes.hpp"
 #include "test_patterns/test_pattern_struct_inheritance.hpp"
+#include "test_patterns/test_pattern_strings.hpp"
+#include "test_patterns/test_pattern_memory_profile.hpp"
 
 std::array Tests = {
     TEST(Placement),
     TEST(Structs),
+    TEST(StructBytes),
     TEST(Unions),
     TEST(Enums),
+    TEST(EnumRanges),
     TEST(Literals),
     TEST(Padding),
     TEST(SucceedingAssert),
     TEST(FailingAssert),
     TEST(Bitfields),
     TEST(ReversedBitfields),
+    TEST(BitfieldCaches),
     TEST(Math),
     TEST(Matching),
+    TEST(AmbiguousMatches),
     TEST(RValues),
     TEST(Namespaces),
     TEST(ExtraSemicolon),
     TEST(Pointers),
     TEST(Arrays),
+    TEST(WhileArrays),
+    TEST(WhileArraysFallback),
+    TEST(NullTerminatedArrays),
+    TEST(NullTerminatedArraysPastEnd),
     TEST(NestedStructs),
     TEST(Attributes),
     TEST(StructInheritance),
+    TEST(Strings),
+    TEST(MemoryProfileLimit),
+    TEST(MemoryProfileFailedDecl),
 };
\ No newline at end of file